@@ -18,6 +18,9 @@
 #include <eosio/asset.hpp>
 #include <eosio/action.hpp>
 #include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
+
+#include <map>
 
 using namespace std;
 using namespace eosio;
@@ -36,11 +39,24 @@ class [[eosio::contract("eosio.amend")]] ratifyamend : public contract {
         struct [[eosio::table, eosio::contract("eosio.amend")]] document {
             uint64_t document_id;
             string document_title;
-            vector<string> clauses; //vector of ipfs urls
+            vector<string> clauses; //legacy ipfs urls, moved to the clauses table by migrate_doc
             uint32_t last_amend;
 
+            binary_extension<uint16_t> clause_count; //number of rows in the document's clauses table
+            binary_extension<uint32_t> version; //incremented every time an amendment is applied
+
             uint64_t primary_key() const { return document_id; }
-            EOSLIB_SERIALIZE(document, (document_id)(document_title)(clauses)(last_amend))
+            EOSLIB_SERIALIZE(document, (document_id)(document_title)(clauses)(last_amend)(clause_count)(version))
+        };
+
+        //NOTE: clauses are scoped by document_id
+        struct [[eosio::table, eosio::contract("eosio.amend")]] clause {
+            uint64_t clause_num;
+            string ipfs_url;
+            uint32_t version; //document version that last wrote this clause
+
+            uint64_t primary_key() const { return clause_num; }
+            EOSLIB_SERIALIZE(clause, (clause_num)(ipfs_url)(version))
         };
 
         struct [[eosio::table, eosio::contract("eosio.amend")]] submission {
@@ -80,6 +96,8 @@ class [[eosio::contract("eosio.amend")]] ratifyamend : public contract {
 
     typedef multi_index<"documents"_n, document> documents_table;
 
+    typedef multi_index<"clauses"_n, clause> clauses_table;
+
     typedef multi_index<"submissions"_n, submission> submissions_table;
 
     typedef singleton<"configs"_n, config> configs_singleton;
@@ -92,7 +110,15 @@ class [[eosio::contract("eosio.amend")]] ratifyamend : public contract {
 
     void update_thresh();
 
-    void update_doc(uint64_t document_id, vector<uint8_t> new_clause_nums, vector<string> new_ipfs_urls);
+    void migrate_doc(documents_table& documents, const document& doc);
+
+    void update_doc(uint64_t document_id, const vector<uint8_t>& new_clause_nums, const vector<string>& new_ipfs_urls);
+
+    asset get_vote_supply();
+
+    void close_submission(const submission& sub, const asset& vote_supply, map<name, asset>& refunds);
+
+    void send_refunds(const map<name, asset>& refunds);
 
     proposals_table::const_iterator find_proposal(uint64_t proposal_id) {
         proposals_table proposals(_self, _self.value);
@@ -131,6 +157,9 @@ class [[eosio::contract("eosio.amend")]] ratifyamend : public contract {
 
 	   	[[eosio::action]]
         void closeprop(uint64_t sub_id);
+
+        [[eosio::action]]
+        void closemany(vector<uint64_t> sub_ids);
         
         [[eosio::action]]
 	    void getdeposit(name owner);
@@ -84,12 +84,25 @@ void ratifyamend::insertdoc(string title, vector<string> clauses) {
 
     uint64_t doc_id = documents.available_primary_key();
 
+    check(clauses.size() <= 256, "document can't have more than 256 clauses");
+
     documents.emplace(_self, [&]( auto& a ){
         a.document_id = doc_id;
         a.document_title = title;
-        a.clauses = clauses;
+        a.last_amend = 0;
+        a.clause_count.emplace(uint16_t(clauses.size()));
+        a.version.emplace(uint32_t(0));
     });
 
+    clauses_table doc_clauses(_self, doc_id);
+    for (uint64_t i = 0; i < clauses.size(); i++) {
+        doc_clauses.emplace(_self, [&]( auto& c ){
+            c.clause_num = i;
+            c.ipfs_url = clauses[i];
+            c.version = 0;
+        });
+    }
+
     print("\nDocument Insertion: SUCCESS");
     print("\nAssigned Document ID: ", doc_id);
 }
@@ -99,8 +112,9 @@ void ratifyamend::makeproposal(string sub_title, uint64_t doc_id, uint8_t new_cl
 
     documents_table documents(_self, _self.value);
     const auto& doc = documents.get(doc_id, "Document Not Found");
+    migrate_doc(documents, doc);
 
-    check(new_clause_num <= doc.clauses.size() && new_clause_num >= 0, "new clause num is not valid");
+    check(new_clause_num <= doc.clause_count.value() && new_clause_num >= 0, "new clause num is not valid");
 	validate_ipfs_link(new_ipfs_url);
 
 	deposits_table deposits(_self, _self.value);
@@ -171,9 +185,10 @@ void ratifyamend::addclause(uint64_t sub_id, uint8_t new_clause_num, string new_
 
     documents_table documents(_self, _self.value);
     const auto& doc = documents.get(sub.document_id, "Document Not Found");
+    migrate_doc(documents, doc);
 
 	validate_ipfs_link(new_ipfs_url);
-    check(new_clause_num <= doc.clauses.size() && new_clause_num >= 0, "new clause num is not valid");
+    check(new_clause_num <= doc.clause_count.value() && new_clause_num >= 0, "new clause num is not valid");
 
     bool does_clause_exist = find(sub.new_clause_nums.begin(), sub.new_clause_nums.end(), new_clause_num) != sub.new_clause_nums.end();
     check(!does_clause_exist, "Clause already exists in this submission");
@@ -285,6 +300,94 @@ void ratifyamend::closeprop(uint64_t sub_id) {
 
 	require_auth(sub.proposer);
 
+    map<name, asset> refunds;
+    close_submission(sub, get_vote_supply(), refunds);
+    send_refunds(refunds);
+}
+
+void ratifyamend::closemany(vector<uint64_t> sub_ids) {
+    check(sub_ids.size() > 0, "Must close at least one proposal");
+
+    sort(sub_ids.begin(), sub_ids.end());
+    check(adjacent_find(sub_ids.begin(), sub_ids.end()) == sub_ids.end(), "Duplicate submission id");
+
+    submissions_table submissions(_self, _self.value);
+    asset vote_supply = get_vote_supply(); //NOTE: registry is read once for the whole batch
+
+    map<name, asset> refunds;
+    for (auto sub_id : sub_ids) {
+        const auto& sub = submissions.get(sub_id, "Proposal Not Found");
+        require_auth(sub.proposer);
+
+        close_submission(sub, vote_supply, refunds);
+    }
+
+    send_refunds(refunds);
+}
+
+#pragma region Helper_Functions
+
+void ratifyamend::migrate_doc(documents_table& documents, const document& doc) {
+    if (doc.clause_count.has_value()) {
+        return;
+    }
+
+    //NOTE: documents inserted before the clauses table keep their urls inline until first read or amended
+    clauses_table doc_clauses(_self, doc.document_id);
+    for (uint64_t i = 0; i < doc.clauses.size(); i++) {
+        doc_clauses.emplace(_self, [&]( auto& c ){
+            c.clause_num = i;
+            c.ipfs_url = doc.clauses[i];
+            c.version = 0;
+        });
+    }
+
+    documents.modify(doc, same_payer, [&]( auto& a ) {
+        a.clause_count.emplace(uint16_t(a.clauses.size()));
+        a.version.emplace(uint32_t(0));
+        a.clauses.clear();
+    });
+}
+
+void ratifyamend::update_doc(uint64_t document_id, const vector<uint8_t>& new_clause_nums, const vector<string>& new_ipfs_urls) {
+    documents_table documents(_self, _self.value);
+    const auto& doc = documents.get(document_id, "Document Not Found");
+    migrate_doc(documents, doc);
+
+    uint32_t new_version = doc.version.value() + 1;
+    uint16_t clause_count = doc.clause_count.value();
+
+    //NOTE: only the amended clause rows are rewritten
+    clauses_table doc_clauses(_self, document_id);
+    for (int i = 0; i < new_clause_nums.size(); i++) {
+        if (new_clause_nums[i] < clause_count) { //update existing clause
+            doc_clauses.modify(doc_clauses.get(new_clause_nums[i]), same_payer, [&]( auto& c ) {
+                c.ipfs_url = new_ipfs_urls.at(i);
+                c.version = new_version;
+            });
+        } else { //add new clause
+            doc_clauses.emplace(_self, [&]( auto& c ) {
+                c.clause_num = clause_count;
+                c.ipfs_url = new_ipfs_urls.at(i);
+                c.version = new_version;
+            });
+            clause_count++;
+        }
+    }
+
+    documents.modify(doc, same_payer, [&]( auto& a ) {
+        a.clause_count.emplace(clause_count);
+        a.version.emplace(new_version);
+        a.last_amend = current_time_point().sec_since_epoch();
+    });
+}
+
+asset ratifyamend::get_vote_supply() {
+    registries_table registries("eosio.trail"_n, "eosio.trail"_n.value);
+    return registries.get(symbol("VOTE", 4).code().raw(), "VOTE registry not found").supply;
+}
+
+void ratifyamend::close_submission(const submission& sub, const asset& vote_supply, map<name, asset>& refunds) {
     ballots_table ballots("eosio.trail"_n, "eosio.trail"_n.value);
     const auto& bal = ballots.get(sub.ballot_id, "Ballot ID doesn't exist");
 	
@@ -294,27 +397,26 @@ void ratifyamend::closeprop(uint64_t sub_id) {
     check(prop.end_time < current_time_point().sec_since_epoch(), "Proposal is still open");
     check(prop.status == uint8_t(0), "Proposal is already closed");
 
-    registries_table registries("eosio.trail"_n, "eosio.trail"_n.value);
-    auto e = registries.find(symbol("VOTE", 4).code().raw());
-
     asset total_votes = prop.yes_count + prop.no_count + prop.abstain_count;
     asset non_abstain_votes = prop.yes_count + prop.no_count; 
 
     //pass thresholds
-    asset quorum = e->supply * configs_struct.threshold_pass_voters / 100;
+    asset quorum = vote_supply * configs_struct.threshold_pass_voters / 100;
     asset votes_pass_thresh = non_abstain_votes * configs_struct.threshold_pass_votes / 100;
 
     //fee refund thresholds
-    asset voters_fee_thresh = e->supply * configs_struct.threshold_fee_voters / 100; 
+    asset voters_fee_thresh = vote_supply * configs_struct.threshold_fee_voters / 100; 
     asset votes_fee_thresh = total_votes * configs_struct.threshold_fee_votes / 100; 
 
     if(prop.yes_count >= votes_fee_thresh && total_votes >= voters_fee_thresh) {
-        action(permission_level{ _self, "active"_n }, "eosio.token"_n, "transfer"_n, make_tuple(
-            _self,
-            sub.proposer,
-            asset(int64_t(configs_struct.fee), symbol("TLOS", 4)),
-            std::string("Ratify/Amend Proposal Fee Refund")
-        )).send();
+        asset fee = asset(int64_t(configs_struct.fee), symbol("TLOS", 4));
+        auto r = refunds.find(sub.proposer);
+
+        if (r == refunds.end()) {
+            refunds.emplace(sub.proposer, fee);
+        } else {
+            r->second += fee;
+        }
     }
 
     uint8_t new_status = uint8_t(2);
@@ -330,25 +432,15 @@ void ratifyamend::closeprop(uint64_t sub_id) {
     )).send();
 }
 
-#pragma region Helper_Functions
-
-void ratifyamend::update_doc(uint64_t document_id, vector<uint8_t> new_clause_nums, vector<string> new_ipfs_urls) {
-    documents_table documents(_self, _self.value);
-    auto d = documents.find(document_id);
-    auto doc = *d;
-
-    auto doc_size = doc.clauses.size();
-    for (int i = 0; i < new_clause_nums.size(); i++) {
-        if (new_clause_nums[i] < doc.clauses.size()) { //update existing clause
-            doc.clauses[new_clause_nums[i]] = new_ipfs_urls.at(i);
-        } else { //add new clause
-            doc.clauses.push_back(new_ipfs_urls.at(i));
-        }
+void ratifyamend::send_refunds(const map<name, asset>& refunds) {
+    for (const auto& r : refunds) {
+        action(permission_level{ _self, "active"_n }, "eosio.token"_n, "transfer"_n, make_tuple(
+            _self,
+            r.first,
+            r.second,
+            std::string("Ratify/Amend Proposal Fee Refund")
+        )).send();
     }
-
-    documents.modify(d, same_payer, [&]( auto& a ) {
-        a.clauses = doc.clauses;
-    });
 }
 
 #pragma endregion Helper_Functions
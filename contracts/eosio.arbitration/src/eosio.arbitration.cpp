@@ -164,28 +164,8 @@ void arbitration::endelection(name nominee) //NOTE: required eosio.arb@eosio.cod
 					  + " seconds")
 			  .c_str());
 
-	//sort board candidates by votes
-	auto board_candidates = board.candidates;
-	sort(board_candidates.begin(), board_candidates.end(), [](const auto &c1, const auto &c2) { return c1.votes > c2.votes; });
-
-	//resolve tie clonficts
-	if (board_candidates.size() > board.available_seats)
-	{
-		auto first_cand_out = board_candidates[board.available_seats];
-		board_candidates.resize(board.available_seats);
-
-		//count candidates that are tied with first_cand_out
-		uint8_t tied_cands = 0;
-		for (int i = board_candidates.size() - 1; i >= 0; i--)
-		{
-			if (board_candidates[i].votes == first_cand_out.votes)
-				tied_cands++;
-		}
-
-		//remove all tied candidates
-		if (tied_cands > 0)
-			board_candidates.resize(board_candidates.size() - tied_cands);
-	}
+	//rank board candidates by votes, dropping candidates tied for the last seat
+	auto board_candidates = get_leaderboard_winners(board);
 
 	nominees_table nominees(get_self(), get_self().value);
 	auto nom_itr = nominees.find(nominee.value);
@@ -57,6 +57,25 @@ namespace eosio {
          [[eosio::action]]
          void approve( name proposer, name proposal_name, permission_level level,
                        const eosio::binary_extension<eosio::checksum256>& proposal_hash );
+
+         /**
+          * Approve proposal with many permission levels
+          *
+          * @details Approves an existing proposal with several permission levels at once,
+          * for example an account approving with more than one of its permissions or a contract
+          * approving on behalf of several accounts. Each of the `levels` permissions must be on the
+          * proposal's requested approval list and is moved to the provided approval list, as with
+          * `approve`, in a single update of the approvals.
+          * Storage changes are billed to `proposer`.
+          *
+          * @param proposer - The account proposing a transaction
+          * @param proposal_name - The name of the proposal (should be unique for proposer)
+          * @param levels - Permission levels approving the transaction
+          * @param proposal_hash - Transaction's checksum
+          */
+         [[eosio::action]]
+         void approvemany( name proposer, name proposal_name, std::vector<permission_level> levels,
+                           const eosio::binary_extension<eosio::checksum256>& proposal_hash );
          /**
           * Revoke proposal
           *
@@ -120,14 +139,17 @@ namespace eosio {
 
          using propose_action = eosio::action_wrapper<"propose"_n, &multisig::propose>;
          using approve_action = eosio::action_wrapper<"approve"_n, &multisig::approve>;
+         using approvemany_action = eosio::action_wrapper<"approvemany"_n, &multisig::approvemany>;
          using unapprove_action = eosio::action_wrapper<"unapprove"_n, &multisig::unapprove>;
          using cancel_action = eosio::action_wrapper<"cancel"_n, &multisig::cancel>;
          using exec_action = eosio::action_wrapper<"exec"_n, &multisig::exec>;
          using invalidate_action = eosio::action_wrapper<"invalidate"_n, &multisig::invalidate>;
       private:
          struct [[eosio::table]] proposal {
-            name                            proposal_name;
-            std::vector<char>               packed_transaction;
+            name                                            proposal_name;
+            std::vector<char>                               packed_transaction;
+            /// sha256 of packed_transaction, absent for proposals created before it was recorded
+            eosio::binary_extension<eosio::checksum256>     trx_hash;
 
             uint64_t primary_key()const { return proposal_name.value; }
          };
@@ -148,8 +170,9 @@ namespace eosio {
             time_point       time;
          };
 
+         /// version 2 keeps requested_approvals sorted by permission level, version 1 rows are sorted when next approved
          struct [[eosio::table]] approvals_info {
-            uint8_t                 version = 1;
+            uint8_t                 version = 2;
             name                    proposal_name;
             //requested approval doesn't need to cointain time, but we want requested approval
             //to be of exact the same size ad provided approval, in this case approve/unapprove
@@ -161,6 +184,9 @@ namespace eosio {
          };
          typedef eosio::multi_index< "approvals2"_n, approvals_info > approvals;
 
+         void approve_levels( name proposer, name proposal_name, const std::vector<permission_level>& levels,
+                              const eosio::binary_extension<eosio::checksum256>& proposal_hash );
+
          struct [[eosio::table]] invalidation {
             name         account;
             time_point   last_invalidation_time;
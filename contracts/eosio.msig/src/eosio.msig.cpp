@@ -44,6 +44,7 @@ void multisig::propose( ignore<name> proposer,
    proptable.emplace( _proposer, [&]( auto& prop ) {
       prop.proposal_name       = _proposal_name;
       prop.packed_transaction  = pkd_trans;
+      prop.trx_hash.emplace( sha256( trx_pos, size ) );
    });
 
    approvals apptable( get_self(), _proposer.value );
@@ -53,6 +54,8 @@ void multisig::propose( ignore<name> proposer,
       for ( auto& level : _requested ) {
          a.requested_approvals.push_back( approval{ level, time_point{ microseconds{0} } } );
       }
+      std::sort( a.requested_approvals.begin(), a.requested_approvals.end(),
+                 []( const approval& l, const approval& r ) { return l.level < r.level; } );
    });
 }
 
@@ -60,33 +63,60 @@ void multisig::approve( name proposer, name proposal_name, permission_level leve
                         const eosio::binary_extension<eosio::checksum256>& proposal_hash )
 {
    require_auth( level );
+   approve_levels( proposer, proposal_name, { level }, proposal_hash );
+}
+
+void multisig::approvemany( name proposer, name proposal_name, std::vector<permission_level> levels,
+                            const eosio::binary_extension<eosio::checksum256>& proposal_hash )
+{
+   check( !levels.empty(), "no permission levels to approve" );
+   for ( const auto& level : levels ) {
+      require_auth( level );
+   }
+   approve_levels( proposer, proposal_name, levels, proposal_hash );
+}
 
+void multisig::approve_levels( name proposer, name proposal_name, const std::vector<permission_level>& levels,
+                               const eosio::binary_extension<eosio::checksum256>& proposal_hash )
+{
    if( proposal_hash ) {
       proposals proptable( get_self(), proposer.value );
       auto& prop = proptable.get( proposal_name.value, "proposal not found" );
-      assert_sha256( prop.packed_transaction.data(), prop.packed_transaction.size(), *proposal_hash );
+      // proposals without a recorded hash, and mismatching hashes, are checked against the packed transaction
+      if( !prop.trx_hash.has_value() || prop.trx_hash.value() != *proposal_hash ) {
+         assert_sha256( prop.packed_transaction.data(), prop.packed_transaction.size(), *proposal_hash );
+      }
    }
 
    approvals apptable( get_self(), proposer.value );
    auto apps_it = apptable.find( proposal_name.value );
    if ( apps_it != apptable.end() ) {
-      auto itr = std::find_if( apps_it->requested_approvals.begin(), apps_it->requested_approvals.end(), [&](const approval& a) { return a.level == level; } );
-      check( itr != apps_it->requested_approvals.end(), "approval is not on the list of requested approvals" );
-
       apptable.modify( apps_it, proposer, [&]( auto& a ) {
-            a.provided_approvals.push_back( approval{ level, current_time_point() } );
-            a.requested_approvals.erase( itr );
+            if ( a.version < 2 ) {
+               std::sort( a.requested_approvals.begin(), a.requested_approvals.end(),
+                          []( const approval& l, const approval& r ) { return l.level < r.level; } );
+               a.version = 2;
+            }
+            const time_point now = current_time_point();
+            for ( const auto& level : levels ) {
+               auto itr = std::lower_bound( a.requested_approvals.begin(), a.requested_approvals.end(), level,
+                                            []( const approval& l, const permission_level& r ) { return l.level < r; } );
+               check( itr != a.requested_approvals.end() && itr->level == level, "approval is not on the list of requested approvals" );
+               a.provided_approvals.push_back( approval{ level, now } );
+               a.requested_approvals.erase( itr );
+            }
          });
    } else {
       old_approvals old_apptable( get_self(), proposer.value );
       auto& apps = old_apptable.get( proposal_name.value, "proposal not found" );
 
-      auto itr = std::find( apps.requested_approvals.begin(), apps.requested_approvals.end(), level );
-      check( itr != apps.requested_approvals.end(), "approval is not on the list of requested approvals" );
-
       old_apptable.modify( apps, proposer, [&]( auto& a ) {
-            a.provided_approvals.push_back( level );
-            a.requested_approvals.erase( itr );
+            for ( const auto& level : levels ) {
+               auto itr = std::find( a.requested_approvals.begin(), a.requested_approvals.end(), level );
+               check( itr != a.requested_approvals.end(), "approval is not on the list of requested approvals" );
+               a.provided_approvals.push_back( level );
+               a.requested_approvals.erase( itr );
+            }
          });
    }
 }
@@ -100,7 +130,14 @@ void multisig::unapprove( name proposer, name proposal_name, permission_level le
       auto itr = std::find_if( apps_it->provided_approvals.begin(), apps_it->provided_approvals.end(), [&](const approval& a) { return a.level == level; } );
       check( itr != apps_it->provided_approvals.end(), "no approval previously granted" );
       apptable.modify( apps_it, proposer, [&]( auto& a ) {
-            a.requested_approvals.push_back( approval{ level, current_time_point() } );
+            const approval app{ level, current_time_point() };
+            if ( a.version < 2 ) {
+               a.requested_approvals.push_back( app );
+            } else {
+               a.requested_approvals.insert( std::upper_bound( a.requested_approvals.begin(), a.requested_approvals.end(), level,
+                                                               []( const permission_level& l, const approval& r ) { return l < r.level; } ),
+                                             app );
+            }
             a.provided_approvals.erase( itr );
          });
    } else {
@@ -155,9 +192,16 @@ void multisig::exec( name proposer, name proposal_name, name executer ) {
    invalidations inv_table( get_self(), get_self().value );
    if ( apps_it != apptable.end() ) {
       approvals.reserve( apps_it->provided_approvals.size() );
+      // levels of one account approved together are adjacent, so their invalidation is looked up once
+      name inv_actor;
+      const invalidation* inv = nullptr;
       for ( auto& p : apps_it->provided_approvals ) {
-         auto it = inv_table.find( p.level.actor.value );
-         if ( it == inv_table.end() || it->last_invalidation_time < p.time ) {
+         if ( p.level.actor != inv_actor ) {
+            inv_actor = p.level.actor;
+            auto it = inv_table.find( inv_actor.value );
+            inv = it == inv_table.end() ? nullptr : &*it;
+         }
+         if ( inv == nullptr || inv->last_invalidation_time < p.time ) {
             approvals.push_back(p.level);
          }
       }
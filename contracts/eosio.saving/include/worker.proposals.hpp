@@ -8,6 +8,8 @@
 #include <eosio/action.hpp>
 #include <eosio/singleton.hpp>
 
+#include <map>
+
 using namespace std;
 using namespace eosio;
 
@@ -72,6 +74,8 @@ class[[eosio::contract("eosio.saving")]] workerproposal : public contract
 
 	[[eosio::action]] void claim(uint64_t sub_id);
 
+	[[eosio::action]] void claimmany(vector<uint64_t> sub_ids);
+
 	[[eosio::action]] void getdeposit(name owner);
 
 	[[eosio::action]] void cancelsub(uint64_t sub_id);
@@ -80,4 +84,10 @@ class[[eosio::contract("eosio.saving")]] workerproposal : public contract
 
 	[[eosio::on_notify("eosio.token::transfer")]]
 	void transfer_handler(name from, name to, asset quantity, string memo);
+
+	asset get_vote_supply();
+
+	void claim_submission(submissions_table& submissions, const submission& sub, const asset& vote_supply, map<name, asset>& payouts);
+
+	void send_payouts(const map<name, asset>& payouts);
 };
@@ -178,6 +178,47 @@ void workerproposal::claim(uint64_t sub_id) {
 
 	require_auth(sub.proposer);
 
+    map<name, asset> payouts;
+    claim_submission(submissions, sub, get_vote_supply(), payouts);
+    send_payouts(payouts);
+}
+
+void workerproposal::claimmany(vector<uint64_t> sub_ids) {
+    check(sub_ids.size() > 0, "Must claim at least one submission");
+
+    sort(sub_ids.begin(), sub_ids.end());
+    check(adjacent_find(sub_ids.begin(), sub_ids.end()) == sub_ids.end(), "Duplicate submission id");
+
+    submissions_table submissions(_self, _self.value);
+    asset vote_supply = get_vote_supply(); //NOTE: registry is read once for the whole batch
+
+    map<name, asset> payouts;
+    for (auto sub_id : sub_ids) {
+        const auto& sub = submissions.get(sub_id, "Worker Proposal Not Found");
+        require_auth(sub.proposer);
+
+        claim_submission(submissions, sub, vote_supply, payouts);
+    }
+
+    send_payouts(payouts);
+}
+
+asset workerproposal::get_vote_supply() {
+    registries_table registries("eosio.trail"_n, "eosio.trail"_n.value);
+    return registries.get(symbol("VOTE", 4).code().raw(), "VOTE registry not found").supply;
+}
+
+static void add_payout(map<name, asset>& payouts, name to, const asset& quantity) {
+    auto p = payouts.find(to);
+
+    if (p == payouts.end()) {
+        payouts.emplace(to, quantity);
+    } else {
+        p->second += quantity;
+    }
+}
+
+void workerproposal::claim_submission(submissions_table& submissions, const submission& sub, const asset& vote_supply, map<name, asset>& payouts) {
     ballots_table ballots("eosio.trail"_n, "eosio.trail"_n.value);
     const auto& bal = ballots.get(sub.ballot_id, "Ballot ID doesn't exist");
 	
@@ -187,52 +228,28 @@ void workerproposal::claim(uint64_t sub_id) {
     check(prop.end_time < current_time_point().sec_since_epoch(), "Cycle is still open");
     check(prop.status == uint8_t(0), "Proposal is closed");
 
-    registries_table registries("eosio.trail"_n, "eosio.trail"_n.value);
-    auto e = registries.find(symbol("VOTE", 4).code().raw());
-
-    asset outstanding = asset(0, symbol("TLOS", 4));
     asset total_votes = prop.yes_count + prop.no_count + prop.abstain_count; //total votes cast on proposal
     asset non_abstain_votes = prop.yes_count + prop.no_count; 
 
     //pass thresholds
-    asset quorum = e->supply * wp_env_struct.threshold_pass_voters / 100;
+    asset quorum = vote_supply * wp_env_struct.threshold_pass_voters / 100;
     asset votes_pass_thresh = non_abstain_votes * wp_env_struct.threshold_pass_votes / 100;
 
     //fee refund thresholds
-    asset voters_fee_thresh = e->supply * wp_env_struct.threshold_fee_voters / 100; 
+    asset voters_fee_thresh = vote_supply * wp_env_struct.threshold_fee_voters / 100; 
     asset votes_fee_thresh = total_votes * wp_env_struct.threshold_fee_votes / 100; 
 
     auto updated_fee = sub.fee;
 
     // print("\n GET FEE BACK WHEN <<<< ", prop.yes_count, " >= ", votes_fee_thresh," && ", total_votes, " >= ", voters_fee_thresh);
     if(sub.fee && prop.yes_count.amount > 0 && prop.yes_count >= votes_fee_thresh && total_votes >= voters_fee_thresh) {
-        asset the_fee = asset(int64_t(sub.fee), symbol("TLOS", 4));
-        if(sub.receiver == sub.proposer) {
-            outstanding += the_fee;
-        } else {
-            action(permission_level{ _self, "active"_n }, "eosio.token"_n, "transfer"_n, make_tuple(
-                _self,
-                sub.proposer,
-                the_fee,
-                std::string("Worker proposal funds")
-            )).send();
-        }
+        add_payout(payouts, sub.proposer, asset(int64_t(sub.fee), symbol("TLOS", 4)));
         updated_fee = 0;
     }
 
     // print("\n GET MUNI WHEN <<<< ", prop.yes_count, " > ", votes_pass_thresh, " && ", total_votes, " >= ", voters_pass_thresh);
     if(prop.yes_count > votes_pass_thresh && total_votes >= quorum) {
-        outstanding += asset(int64_t(sub.amount), symbol("TLOS", 4));
-    }
-    
-    // print("\n numbers : ", total_votes, " * ", wp_env_struct.threshold_pass_voters, " | ", wp_env_struct.threshold_fee_voters, " ---- ", total_votes, " ", prop.yes_count, " ", prop.no_count);
-    if(outstanding.amount > 0) {
-        action(permission_level{ _self, "active"_n }, "eosio.token"_n, "transfer"_n, make_tuple(
-            _self,
-            sub.receiver,
-            outstanding,
-            std::string("Worker proposal funds") //TODO: improve memo messaging
-        )).send();
+        add_payout(payouts, sub.receiver, asset(int64_t(sub.amount), symbol("TLOS", 4)));
     }
 
     if(prop.cycle_count == uint16_t(sub.cycles - 1)) { //Close ballot because it was the last cycle for the submission.
@@ -258,6 +275,17 @@ void workerproposal::claim(uint64_t sub_id) {
     });
 }
 
+void workerproposal::send_payouts(const map<name, asset>& payouts) {
+    for (const auto& p : payouts) {
+        action(permission_level{ _self, "active"_n }, "eosio.token"_n, "transfer"_n, make_tuple(
+            _self,
+            p.first,
+            p.second,
+            std::string("Worker proposal funds") //TODO: improve memo messaging
+        )).send();
+    }
+}
+
 // note : this gets called when eosio.saving transfers OUT tokens too 
 // => deposits.owner eosio.saving will contain the entire sum of what was paid out , EVER (including fees and everything)
 void workerproposal::transfer_handler(name from, name to, asset quantity, string memo) {
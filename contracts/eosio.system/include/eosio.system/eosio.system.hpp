@@ -1,6 +1,7 @@
 #pragma once
 
 #include <eosio/asset.hpp>
+#include <eosio/binary_extension.hpp>
 #include <eosio/privileged.hpp>
 #include <eosio/singleton.hpp>
 #include <eosio/system.hpp>
@@ -14,6 +15,7 @@
 #include <type_traits>
 #include <optional>
 #include <deque>
+#include <map>
 #include <type_traits>
 #include <optional>
 
@@ -54,6 +56,8 @@ namespace eosiosystem {
    static constexpr int64_t  inflation_pay_factor  = 5;                // 20% of the inflation
    static constexpr int64_t  votepay_factor        = 4;                // 25% of the producer pay
    static constexpr uint32_t refund_delay_sec      = 3 * seconds_per_day;
+   static constexpr uint16_t default_vote_settlements = 5;             // pending voters settled per schedule update, see setsettlemax
+   static constexpr uint16_t max_vote_settlements  = 20;               // upper bound for setsettlemax, each voter can touch 30 producers
 
    /*
     * NOTE: 1000 is used only to make the unit tests pass.
@@ -75,6 +79,15 @@ namespace eosiosystem {
 
    typedef eosio::multi_index< "payments"_n, payment_info > payments_table;
 
+   struct [[eosio::table("payledger"), eosio::contract("eosio.system")]] payment_ledger {
+      /// accrued pay of active producers, sorted by bp; inactive producers keep theirs in the payments table
+      std::vector<payment_info> payments;
+
+      EOSLIB_SERIALIZE(payment_ledger, (payments))
+   };
+
+   typedef eosio::singleton< "payledger"_n, payment_ledger > payment_ledger_singleton;
+
    struct [[eosio::table("schedulemetr"), eosio::contract("eosio.system")]] schedule_metrics_state {
      name                     last_onblock_caller;
      int32_t                          block_counter_correction;
@@ -96,6 +109,9 @@ namespace eosiosystem {
       block_timestamp         next_rotation_time;
       block_timestamp         last_rotation_time;
 
+      /// hash of the last sorted schedule accepted by set_proposed_producers
+      eosio::binary_extension<eosio::checksum256> last_proposed_hash;
+
       //NOTE: This might not be the best place for this information
 
       // bool                            is_kick_active = true;
@@ -103,7 +119,7 @@ namespace eosiosystem {
       // block_timestamp                 last_time_block_produced;
 
       EOSLIB_SERIALIZE( rotation_state, /*(is_rotation_active)*/(bp_currently_out)(sbp_currently_in)(bp_out_index)(sbp_in_index)(next_rotation_time)
-                        (last_rotation_time)/*(is_kick_active)(last_onblock_caller)(last_time_block_produced)*/ )
+                        (last_rotation_time)/*(is_kick_active)(last_onblock_caller)(last_time_block_produced)*/(last_proposed_hash) )
    };
 
    typedef eosio::singleton< "rotations"_n, rotation_state> rotation_singleton;
@@ -159,6 +175,22 @@ namespace eosiosystem {
       uint64_t primary_key()const { return bidder.value; }
    };
 
+   /**
+    * A pending bid refund.
+    *
+    * @details Points to a `bid_refund` waiting to be paid out by `sweeprefunds`:
+    * - the `id` orders pending refunds by the time the bidder was outbid
+    * - the `bidder` account name owning the refund
+    * - the `newname` scoping the refund
+    */
+   struct [[eosio::table, eosio::contract("eosio.system")]] pending_bid_refund {
+      uint64_t     id;
+      name         bidder;
+      name         newname;
+
+      uint64_t primary_key()const { return id; }
+   };
+
    /**
     * Name bid table
     *
@@ -175,6 +207,13 @@ namespace eosiosystem {
     */
    typedef eosio::multi_index< "bidrefunds"_n, bid_refund > bid_refund_table;
 
+   /**
+    * Pending bid refund table.
+    *
+    * @details The pending bid refund table is storing all the `pending_bid_refund`s instances.
+    */
+   typedef eosio::multi_index< "refundqueue"_n, pending_bid_refund > pending_bid_refund_table;
+
    /**
     * Defines new global state parameters.
     */
@@ -317,7 +356,8 @@ namespace eosiosystem {
       enum class flags1_fields : uint32_t {
          ram_managed = 1,
          net_managed = 2,
-         cpu_managed = 4
+         cpu_managed = 4,
+         lazy_votes  = 8   /// stake changes are queued in `pendingvotes` instead of updating producers right away
       };
 
       // explicit serialization macro is not necessary, used here only to improve compilation time
@@ -331,6 +371,45 @@ namespace eosiosystem {
     */
    typedef eosio::multi_index< "voters"_n, voter_info >  voters_table;
 
+   /**
+    * A voter with unsettled vote weight.
+    *
+    * @details Queued when the stake of a voter using lazy vote settlement changes. Producer totals for
+    * `owner` catch up the next time they vote, when `settlevotes` runs, or on the next schedule update.
+    * `id` only grows while the queue is non-empty, so the primary index settles voters in the order
+    * they were queued.
+    */
+   struct [[eosio::table, eosio::contract("eosio.system")]] pending_vote {
+      uint64_t     id;
+      name         owner;
+
+      uint64_t primary_key()const { return id; }
+      uint64_t by_owner()const    { return owner.value; }
+   };
+
+   /**
+    * Pending votes table
+    *
+    * @details The pending votes table is storing all the `pending_vote`s instances, indexed by queue order and owner.
+    */
+   typedef eosio::multi_index< "pendingvotes"_n, pending_vote,
+                               indexed_by<"byowner"_n, const_mem_fun<pending_vote, uint64_t, &pending_vote::by_owner>>
+                             > pending_votes_table;
+
+   /**
+    * `vote_settlement_state` structure underlying the vote settlement singleton.
+    *
+    * @details
+    * - `onblock_budget` number of pending voters settled before each producer schedule update, zero disables it.
+    */
+   struct [[eosio::table("votesettle"), eosio::contract("eosio.system")]] vote_settlement_state {
+      uint16_t onblock_budget = default_vote_settlements;
+
+      EOSLIB_SERIALIZE( vote_settlement_state, (onblock_budget) )
+   };
+
+   typedef eosio::singleton< "votesettle"_n, vote_settlement_state > vote_settlement_singleton;
+
 
    /**
     * Defines producer info table added in version 1.0
@@ -470,15 +549,51 @@ namespace eosiosystem {
     */
    typedef eosio::multi_index< "rexfund"_n, rex_fund > rex_fund_table;
 
+   /**
+    * `rex_maturity_buckets` structure holding the REX maturity buckets of a rex balance.
+    *
+    * @details At most 6 daily buckets are live at any time, so only the live buckets are stored,
+    * oldest first, in a vector that never grows past `capacity`:
+    * - `buckets` the live buckets, each holding a maturity time and an amount of REX,
+    * - `savings` REX in the savings bucket, which never matures.
+    */
+   struct rex_maturity_buckets {
+      static constexpr uint8_t capacity = 6;
+
+      std::vector<std::pair<time_point_sec, int64_t>> buckets;
+      int64_t savings = 0;
+
+      bool empty()const { return buckets.empty(); }
+      std::pair<time_point_sec, int64_t>& front() { return buckets.front(); }
+      std::pair<time_point_sec, int64_t>& back() { return buckets.back(); }
+
+      void pop_front() { buckets.erase( buckets.begin() ); }
+      void pop_back() { buckets.pop_back(); }
+
+      /// adds REX to the newest bucket if it has the same maturity, otherwise opens a new bucket
+      void add( const time_point_sec& maturity, int64_t rex ) {
+         if ( !empty() && back().first == maturity ) {
+            back().second += rex;
+            return;
+         }
+         check( buckets.size() < capacity, "too many REX maturity buckets" );
+         buckets.emplace_back( maturity, rex );
+      }
+
+      EOSLIB_SERIALIZE( rex_maturity_buckets, (buckets)(savings) )
+   };
+
    /**
     * `rex_balance` structure underlying the rex balance table.
     *
     * @details A rex balance table entry is defined by:
-    * - `version` defaulted to zero,
+    * - `version` zero for rows keeping maturities in `rex_maturities`, one for rows using `maturity_buckets`,
     * - `owner` the owner of the rex fund,
     * - `vote_stake` the amount of CORE_SYMBOL currently included in owner's vote,
     * - `rex_balance` the amount of REX owned by owner,
-    * - `matured_rex` matured REX available for selling.
+    * - `matured_rex` matured REX available for selling,
+    * - `rex_maturities` legacy REX daily maturity buckets, emptied when the row is migrated,
+    * - `maturity_buckets` REX daily maturity buckets and savings.
     */
    struct [[eosio::table,eosio::contract("eosio.system")]] rex_balance {
       uint8_t version = 0;
@@ -486,9 +601,12 @@ namespace eosiosystem {
       asset   vote_stake;
       asset   rex_balance;
       int64_t matured_rex = 0;
-      std::deque<std::pair<time_point_sec, int64_t>> rex_maturities; /// REX daily maturity buckets
+      std::deque<std::pair<time_point_sec, int64_t>> rex_maturities; /// legacy REX daily maturity buckets
+      eosio::binary_extension<rex_maturity_buckets> maturity_buckets;
 
       uint64_t primary_key()const { return owner.value; }
+
+      EOSLIB_SERIALIZE( rex_balance, (version)(owner)(vote_stake)(rex_balance)(matured_rex)(rex_maturities)(maturity_buckets) )
    };
 
    /**
@@ -575,6 +693,86 @@ namespace eosiosystem {
       asset stake_change;
    };
 
+   /**
+    * `rex_maintenance_state` structure underlying the rex maintenance singleton.
+    *
+    * @details Queue depths let REX maintenance triggered by user actions split its work budget
+    * across the three queues by backlog, and can be read to monitor the backlog:
+    * - `work_budget` number of queue items processed by maintenance run from a REX action,
+    * - `cpu_loans` number of open CPU loans,
+    * - `net_loans` number of open NET loans,
+    * - `sell_orders` number of queued sellrex orders,
+    * - `processed` total number of queue items processed by maintenance.
+    */
+   struct [[eosio::table("rexmaint"), eosio::contract("eosio.system")]] rex_maintenance_state {
+      uint16_t work_budget = 6;
+      uint32_t cpu_loans   = 0;
+      uint32_t net_loans   = 0;
+      uint32_t sell_orders = 0;
+      uint64_t processed   = 0;
+
+      EOSLIB_SERIALIZE( rex_maintenance_state, (work_budget)(cpu_loans)(net_loans)(sell_orders)(processed) )
+   };
+
+   typedef eosio::singleton< "rexmaint"_n, rex_maintenance_state > rex_maintenance_singleton;
+
+   /// number of CPU loans, NET loans and sell orders, either to be processed or processed by REX maintenance
+   struct rex_queue_counts {
+      uint16_t cpu_loans   = 0;
+      uint16_t net_loans   = 0;
+      uint16_t sell_orders = 0;
+
+      uint32_t total()const { return uint32_t(cpu_loans) + net_loans + sell_orders; }
+   };
+
+   /**
+    * `rex_loan_batch` structure accumulating the settlement of a batch of expired REX loans.
+    *
+    * @details Loans are settled one after the other against local copies of the REX pool totals,
+    * which gives the same totals as adjusting the pool for every loan, and resource limit changes
+    * are summed per receiver:
+    * - `total_rent`, `total_unlent`, `total_lent` REX pool totals updated by the settled loans,
+    * - `settled` number of loans settled,
+    * - `resource_deltas` NET and CPU stake changes per receiver, with the account charged for RAM.
+    */
+   struct rex_loan_batch {
+      struct resource_delta {
+         name    from;
+         int64_t net = 0;
+         int64_t cpu = 0;
+      };
+
+      int64_t  total_rent   = 0;
+      int64_t  total_unlent = 0;
+      int64_t  total_lent   = 0;
+      uint32_t settled      = 0;
+      std::map<name, resource_delta> resource_deltas;
+
+      /// moves the tokens staked by an expiring loan back to unlent and deducts its share of total_rent
+      void remove_loan( const rex_loan& loan ) {
+         const int64_t delta_total_rent = exchange_state::get_bancor_output( total_unlent, total_rent,
+                                                                             loan.total_staked.amount );
+         total_rent   -= delta_total_rent;
+         total_unlent += loan.total_staked.amount;
+         total_lent   -= loan.total_staked.amount;
+         ++settled;
+      }
+
+      /// accounts for a renewed loan, mirroring add_loan_to_rex_pool
+      void add_loan( int64_t payment, int64_t rented_tokens ) {
+         total_rent   += payment;
+         total_unlent -= rented_tokens;
+         total_lent   += rented_tokens;
+         total_unlent += payment;
+      }
+
+      void add_resource_delta( const name& from, const name& receiver, int64_t delta_net, int64_t delta_cpu ) {
+         auto& delta = resource_deltas.try_emplace( receiver, resource_delta{ from } ).first->second;
+         delta.net += delta_net;
+         delta.cpu += delta_cpu;
+      }
+   };
+
    /**
     * The EOSIO system contract.
     *
@@ -589,9 +787,16 @@ namespace eosiosystem {
          eosio_global_state          _gstate;
          rammarket                   _rammarket;
 		   rex_pool_table          	 _rexpool;
+         mutable std::optional<rex_pool> _grexpool;
+         mutable bool                _grexpool_loaded = false;
+         bool                        _grexpool_dirty  = false;
          rex_fund_table          	 _rexfunds;
          rex_balance_table       	 _rexbalance;
          rex_order_table         	 _rexorders;
+         rex_maintenance_singleton   _rexmaint;
+         mutable rex_maintenance_state _grexmaint;
+         mutable bool                _grexmaint_loaded = false;
+         bool                        _grexmaint_dirty  = false;
 
          schedule_metrics_singleton  _schedule_metrics;
          schedule_metrics_state      _gschedule_metrics;
@@ -778,6 +983,16 @@ namespace eosiosystem {
          [[eosio::action]]
          void setrex( const asset& balance );
 
+         /**
+          * Setrexbudget action.
+          *
+          * @details Sets the number of queue items, split across expired CPU loans, expired NET loans
+          * and sell orders by backlog, that REX maintenance processes when run from a REX action.
+          * @param work_budget - number of queue items processed per run.
+          */
+         [[eosio::action]]
+         void setrexbudget( uint16_t work_budget );
+
          /**
           * Deposit to REX fund action.
           *
@@ -1104,6 +1319,19 @@ namespace eosiosystem {
          [[eosio::action]]
          void buyrambytes( const name& payer, const name& receiver, uint32_t bytes );
 
+         /**
+          * Buy specific amounts of ram bytes for many receivers action.
+          *
+          * @details Prices the total number of bytes in one market conversion and executes a single
+          * inline transfer of tokens and a single fee transfer from payer to system contract. The
+          * bytes delivered are split among receivers in proportion to the bytes each requested.
+          *
+          * @param payer - the ram buyer,
+          * @param purchases - list of ram receivers and the quantity of ram to buy for each, in bytes.
+          */
+         [[eosio::action]]
+         void buyrambatch( const name& payer, const std::vector<std::pair<name, uint32_t>>& purchases );
+
          /**
           * Sell ram action.
           *
@@ -1227,6 +1455,47 @@ namespace eosiosystem {
          [[eosio::action]]
          void regproxy( const name& proxy, bool isproxy );
 
+         /**
+          * Set lazy votes action.
+          *
+          * @details Opts `voter` in or out of lazy vote settlement. While enabled, stake changes only
+          * update `voter`'s own stake and queue the voter in the pending votes table. The weight of the
+          * voted producers is brought up to date when `voter` next votes, when `settlevotes` runs, or on
+          * the next producer schedule update. Disabling settles any pending change right away.
+          * Storage change is billed to `voter`.
+          *
+          * @param voter - the account to change the settlement mode for,
+          * @param enabled - true to queue stake changes, false to apply them immediately.
+          *
+          * @pre Voter must have previously staked some TLOS for voting
+          * @pre New state must be different than current state
+          */
+         [[eosio::action]]
+         void setlazyvotes( const name& voter, bool enabled );
+
+         /**
+          * Settle votes action.
+          *
+          * @details Applies the queued stake changes of up to `max` voters to the producers they vote for.
+          * Can be called by any account.
+          *
+          * @param max - maximum number of pending voters to settle.
+          */
+         [[eosio::action]]
+         void settlevotes( uint16_t max );
+
+         /**
+          * Set settle max action.
+          *
+          * @details Sets the number of pending voters settled in `onblock` before each producer schedule
+          * update. Each settled voter can update up to 30 producer rows. Zero leaves settlement to
+          * `settlevotes` and to voters voting again.
+          *
+          * @param onblock_budget - number of pending voters settled per schedule update.
+          */
+         [[eosio::action]]
+         void setsettlemax( uint16_t onblock_budget );
+
          /**
           * Set the blockchain parameters
           *
@@ -1310,6 +1579,17 @@ namespace eosiosystem {
          [[eosio::action]]
          void bidrefund( const name& bidder, const name& newname );
 
+         /**
+          * Sweep refunds action.
+          *
+          * @details Pays out up to `max` pending bid refunds of outbid bidders, oldest first.
+          * Can be called by any account.
+          *
+          * @param max - maximum number of pending refunds to pay out.
+          */
+         [[eosio::action]]
+         void sweeprefunds( uint16_t max );
+
          [[eosio::action]]
          void votebpout(name bp, uint32_t penalty_hours);
 
@@ -1339,6 +1619,7 @@ namespace eosiosystem {
          using updaterex_action = eosio::action_wrapper<"updaterex"_n, &system_contract::updaterex>;
          using rexexec_action = eosio::action_wrapper<"rexexec"_n, &system_contract::rexexec>;
          using setrex_action = eosio::action_wrapper<"setrex"_n, &system_contract::setrex>;
+         using setrexbudget_action = eosio::action_wrapper<"setrexbudget"_n, &system_contract::setrexbudget>;
          using mvtosavings_action = eosio::action_wrapper<"mvtosavings"_n, &system_contract::mvtosavings>;
          using mvfrsavings_action = eosio::action_wrapper<"mvfrsavings"_n, &system_contract::mvfrsavings>;
          using consolidate_action = eosio::action_wrapper<"consolidate"_n, &system_contract::consolidate>;
@@ -1346,6 +1627,7 @@ namespace eosiosystem {
          using undelegatebw_action = eosio::action_wrapper<"undelegatebw"_n, &system_contract::undelegatebw>;
          using buyram_action = eosio::action_wrapper<"buyram"_n, &system_contract::buyram>;
          using buyrambytes_action = eosio::action_wrapper<"buyrambytes"_n, &system_contract::buyrambytes>;
+         using buyrambatch_action = eosio::action_wrapper<"buyrambatch"_n, &system_contract::buyrambatch>;
          using sellram_action = eosio::action_wrapper<"sellram"_n, &system_contract::sellram>;
          using refund_action = eosio::action_wrapper<"refund"_n, &system_contract::refund>;
          using regproducer_action = eosio::action_wrapper<"regproducer"_n, &system_contract::regproducer>;
@@ -1354,11 +1636,15 @@ namespace eosiosystem {
          using setramrate_action = eosio::action_wrapper<"setramrate"_n, &system_contract::setramrate>;
          using voteproducer_action = eosio::action_wrapper<"voteproducer"_n, &system_contract::voteproducer>;
          using regproxy_action = eosio::action_wrapper<"regproxy"_n, &system_contract::regproxy>;
+         using setlazyvotes_action = eosio::action_wrapper<"setlazyvotes"_n, &system_contract::setlazyvotes>;
+         using settlevotes_action = eosio::action_wrapper<"settlevotes"_n, &system_contract::settlevotes>;
+         using setsettlemax_action = eosio::action_wrapper<"setsettlemax"_n, &system_contract::setsettlemax>;
          using claimrewards_action = eosio::action_wrapper<"claimrewards"_n, &system_contract::claimrewards>;
          using rmvproducer_action = eosio::action_wrapper<"rmvproducer"_n, &system_contract::rmvproducer>;
          using updtrevision_action = eosio::action_wrapper<"updtrevision"_n, &system_contract::updtrevision>;
          using bidname_action = eosio::action_wrapper<"bidname"_n, &system_contract::bidname>;
          using bidrefund_action = eosio::action_wrapper<"bidrefund"_n, &system_contract::bidrefund>;
+         using sweeprefunds_action = eosio::action_wrapper<"sweeprefunds"_n, &system_contract::sweeprefunds>;
          using setpriv_action = eosio::action_wrapper<"setpriv"_n, &system_contract::setpriv>;
          using setalimits_action = eosio::action_wrapper<"setalimits"_n, &system_contract::setalimits>;
          using setparams_action = eosio::action_wrapper<"setparams"_n, &system_contract::setparams>;
@@ -1379,10 +1665,16 @@ namespace eosiosystem {
 
          // defined in rex.cpp
          void runrex( uint16_t max );
+         void runrex();
+         rex_queue_counts process_rex_queues( const rex_queue_counts& max );
+         static rex_queue_counts split_rex_budget( uint16_t budget, const rex_maintenance_state& maint );
+         const rex_maintenance_state& get_rex_maintenance()const;
+         rex_maintenance_state& update_rex_maintenance();
+         void put_rex_maintenance();
          void update_resource_limits( const name& from, const name& receiver, int64_t delta_net, int64_t delta_cpu );
          void check_voting_requirement( const name& owner,
                                         const char* error_msg = "must vote for at least 21 producers or for a proxy before buying REX" )const;
-         rex_order_outcome fill_rex_order( const rex_balance_table::const_iterator& bitr, const asset& rex );
+         rex_order_outcome fill_rex_order( rex_balance& rb, const asset& rex );
          asset update_rex_account( const name& owner, const asset& proceeds, const asset& unstake_quant, bool force_vote_update = false );
          void channel_to_rex( const name& from, const asset& amount );
          void channel_namebid_to_rex( const int64_t highest_bid );
@@ -1395,28 +1687,36 @@ namespace eosiosystem {
          void transfer_from_fund( const name& owner, const asset& amount );
          void transfer_to_fund( const name& owner, const asset& amount );
          bool rex_loans_available()const;
-         bool rex_system_initialized()const { return _rexpool.begin() != _rexpool.end(); }
-         bool rex_available()const { return rex_system_initialized() && _rexpool.begin()->total_rex.amount > 0; }
+         bool rex_system_initialized()const { return get_rex_pool().has_value(); }
+         bool rex_available()const { return rex_system_initialized() && get_rex_pool()->total_rex.amount > 0; }
+         const std::optional<rex_pool>& get_rex_pool()const;
+         rex_pool& update_rex_pool();
+         void put_rex_pool();
          static time_point_sec get_rex_maturity();
          asset add_to_rex_balance( const name& owner, const asset& payment, const asset& rex_received );
          asset add_to_rex_pool( const asset& payment );
-         void process_rex_maturities( const rex_balance_table::const_iterator& bitr );
-         void consolidate_rex_balance( const rex_balance_table::const_iterator& bitr,
-                                       const asset& rex_in_sell_order );
-         int64_t read_rex_savings( const rex_balance_table::const_iterator& bitr );
-         void put_rex_savings( const rex_balance_table::const_iterator& bitr, int64_t rex );
+         void process_rex_maturities( rex_balance& rb );
+         void consolidate_rex_balance( rex_balance& rb, const asset& rex_in_sell_order );
+         rex_balance load_rex_balance( const rex_balance_table::const_iterator& bitr );
+         void put_rex_balance( const rex_balance_table::const_iterator& bitr, const rex_balance& rb );
          void update_rex_stake( const name& voter );
 
          void add_loan_to_rex_pool( const asset& payment, int64_t rented_tokens, bool new_loan );
-         void remove_loan_from_rex_pool( const rex_loan& loan );
+         template <typename Index>
+         uint16_t settle_expired_loans( Index& idx, uint16_t max, bool cpu, rex_loan_batch& batch );
          template <typename Index, typename Iterator>
          int64_t update_renewed_loan( Index& idx, const Iterator& itr, int64_t rented_tokens );
 
          // defined in delegate_bandwidth.cpp
+         int64_t purchase_ram( const name& payer, const asset& quant );
+         void add_ram_bytes( const name& receiver, int64_t bytes );
          void changebw( name from, const name& receiver,
                         const asset& stake_net_quantity, const asset& stake_cpu_quantity, bool transfer );
          void update_voting_power( const name& voter, const asset& total_update );
 
+         // defined in name_bidding.cpp
+         void pay_bid_refund( bid_refund_table& refunds_table, const bid_refund_table::const_iterator& it, const name& newname );
+
          // defined in producer_pay.cpp
          void claimrewards_snapshot();
 
@@ -1424,6 +1724,8 @@ namespace eosiosystem {
          void update_elected_producers( const block_timestamp& timestamp );
          void update_votes( const name& voter, const name& proxy, const std::vector<name>& producers, bool voting );
          void propagate_weight_change( const voter_info& voter );
+         uint16_t settle_pending_votes( uint16_t max );
+         void erase_pending_vote( const name& voter, bool settle );
 
          double inverse_vote_weight(double staked, double amountVotedProducers);
          void recalculate_votes();
@@ -50,6 +50,48 @@ namespace eosiosystem {
       require_auth( payer );
       update_ram_supply();
 
+      const int64_t bytes_out = purchase_ram( payer, quant );
+      add_ram_bytes( receiver, bytes_out );
+   }
+
+   /**
+    *  Buying ram for many receivers prices the sum of the requested bytes with a single market
+    *  conversion and bills the payer with one transfer for the tokens and one for the fee.
+    *  The bytes delivered by the market are split in proportion to the bytes requested, with
+    *  any rounding remainder going to the last receiver.
+    */
+   void system_contract::buyrambatch( const name& payer, const std::vector<std::pair<name, uint32_t>>& purchases )
+   {
+      require_auth( payer );
+      update_ram_supply();
+
+      check( !purchases.empty(), "no ram purchases" );
+      int64_t total_bytes = 0;
+      for ( const auto& p : purchases ) {
+         check( p.second > 0, "must purchase a positive amount" );
+         total_bytes += p.second;
+      }
+
+      const auto& market          = _rammarket.get(ramcore_symbol.raw(), "ram market does not exist");
+      const int64_t cost          = exchange_state::get_bancor_input( market.base.balance.amount, market.quote.balance.amount, total_bytes );
+      const int64_t cost_plus_fee = cost / double(0.995);
+      const int64_t bytes_out     = purchase_ram( payer, asset{ cost_plus_fee, core_symbol() } );
+
+      int64_t bytes_left = bytes_out;
+      for ( size_t i = 0; i < purchases.size(); ++i ) {
+         const int64_t bytes = ( i + 1 == purchases.size() ) ? bytes_left
+                                                             : ( uint128_t(bytes_out) * purchases[i].second ) / total_bytes;
+         bytes_left -= bytes;
+         add_ram_bytes( purchases[i].first, bytes );
+      }
+   }
+
+   /**
+    *  Transfers quant less a .5% fee from payer to eosio.ram and the fee to eosio.ramfee, and
+    *  converts it to bytes at the current market price. Returns the number of bytes reserved.
+    */
+   int64_t system_contract::purchase_ram( const name& payer, const asset& quant )
+   {
       check( quant.symbol == core_symbol(), "must buy ram with core token" );
       check( quant.amount > 0, "must purchase a positive amount" );
 
@@ -84,6 +126,14 @@ namespace eosiosystem {
       _gstate.total_ram_bytes_reserved += uint64_t(bytes_out);
       _gstate.total_ram_stake          += quant_after_fee.amount;
 
+      return bytes_out;
+   }
+
+   /**
+    *  Adds bytes to the ram quota of receiver and, unless ram is managed, to its resource limits.
+    */
+   void system_contract::add_ram_bytes( const name& receiver, int64_t bytes )
+   {
       user_resources_table  userres( get_self(), receiver.value );
       auto res_itr = userres.find( receiver.value );
       if( res_itr ==  userres.end() ) {
@@ -91,11 +141,11 @@ namespace eosiosystem {
                res.owner = receiver;
                res.net_weight = asset( 0, core_symbol() );
                res.cpu_weight = asset( 0, core_symbol() );
-               res.ram_bytes = bytes_out;
+               res.ram_bytes = bytes;
             });
       } else {
          userres.modify( res_itr, receiver, [&]( auto& res ) {
-               res.ram_bytes += bytes_out;
+               res.ram_bytes += bytes;
             });
       }
 
@@ -369,7 +419,17 @@ namespace eosiosystem {
     //      validate_b1_vesting( voter_itr->staked );
     //   }
 
-      if( voter_itr->producers.size() || voter_itr->proxy ) {
+      if( voter_itr->producers.size() && has_field( voter_itr->flags1, voter_info::flags1_fields::lazy_votes ) ) {
+         /// staked already holds the new amount, update_votes settles it against last_stake later
+         pending_votes_table pending( get_self(), get_self().value );
+         auto owner_index = pending.get_index<"byowner"_n>();
+         if( owner_index.find( voter.value ) == owner_index.end() ) {
+            pending.emplace( voter, [&]( auto& p ) {
+               p.id    = pending.available_primary_key();
+               p.owner = voter;
+            });
+         }
+      } else if( voter_itr->producers.size() || voter_itr->proxy ) {
          update_votes( voter, voter_itr->proxy, voter_itr->producers, false );
       }
    }
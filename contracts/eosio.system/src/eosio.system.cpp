@@ -22,7 +22,8 @@ namespace eosiosystem {
 	_rexpool(_self, _self.value),
     _rexfunds(_self, _self.value),
     _rexbalance(_self, _self.value),
-    _rexorders(_self, _self.value)
+    _rexorders(_self, _self.value),
+    _rexmaint(_self, _self.value)
    {
       //print( "construct system\n" );
       _gstate  = _global.exists() ? _global.get() : get_default_parameters();
@@ -48,6 +49,8 @@ namespace eosiosystem {
       _schedule_metrics.set(_gschedule_metrics, _self);
       _rotation.set(_grotation, _self);
       _payrate.set(_gpayrate, _self);
+      put_rex_pool();
+      put_rex_maintenance();
    }
 
    void system_contract::setram( uint64_t max_ram_size ) {
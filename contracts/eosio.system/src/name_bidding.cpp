@@ -1,8 +1,6 @@
 #include <eosio.system/eosio.system.hpp>
 #include <eosio.token/eosio.token.hpp>
 
-#include <eosio/transaction.hpp>
-
 namespace eosiosystem {
 
    using eosio::current_time_point;
@@ -47,18 +45,15 @@ namespace eosiosystem {
                   r.bidder = current->high_bidder;
                   r.amount = asset( current->high_bid, core_symbol() );
                });
+            /// queue the new refund to be paid out by sweeprefunds
+            pending_bid_refund_table pending( get_self(), get_self().value );
+            pending.emplace( bidder, [&](auto& p) {
+                  p.id      = pending.available_primary_key();
+                  p.bidder  = current->high_bidder;
+                  p.newname = newname;
+               });
          }
 
-         eosio::transaction t;
-         t.actions.emplace_back( permission_level{get_self(), active_permission},
-                                 get_self(), "bidrefund"_n,
-                                 std::make_tuple( current->high_bidder, newname )
-         );
-         t.delay_sec = 0;
-         uint128_t deferred_id = (uint128_t(newname.value) << 64) | current->high_bidder.value;
-         eosio::cancel_deferred( deferred_id );
-         t.send( deferred_id, bidder );
-
          bids.modify( current, bidder, [&]( auto& b ) {
             b.high_bidder = bidder;
             b.high_bid = bid.amount;
@@ -72,8 +67,32 @@ namespace eosiosystem {
       auto it = refunds_table.find( bidder.value );
       check( it != refunds_table.end(), "refund not found" );
 
-      token::transfer_action transfer_act{ token_account, { {names_account, active_permission}, {bidder, active_permission} } };
-      transfer_act.send( names_account, bidder, asset(it->amount), std::string("refund bid on name ")+(name{newname}).to_string() );
+      pay_bid_refund( refunds_table, it, newname );
+   }
+
+   void system_contract::sweeprefunds( uint16_t max ) {
+      check( max > 0, "max must be positive" );
+
+      pending_bid_refund_table pending( get_self(), get_self().value );
+      check( pending.begin() != pending.end(), "no bid refunds to sweep" );
+
+      for ( uint16_t i = 0; i < max; ++i ) {
+         auto itr = pending.begin();
+         if ( itr == pending.end() ) break;
+
+         /// refunds already claimed with bidrefund leave their queue entry behind
+         bid_refund_table refunds_table( get_self(), itr->newname.value );
+         auto it = refunds_table.find( itr->bidder.value );
+         if ( it != refunds_table.end() ) {
+            pay_bid_refund( refunds_table, it, itr->newname );
+         }
+         pending.erase( itr );
+      }
+   }
+
+   void system_contract::pay_bid_refund( bid_refund_table& refunds_table, const bid_refund_table::const_iterator& it, const name& newname ) {
+      token::transfer_action transfer_act{ token_account, { {names_account, active_permission}, {it->bidder, active_permission} } };
+      transfer_act.send( names_account, it->bidder, asset(it->amount), std::string("refund bid on name ")+(name{newname}).to_string() );
       refunds_table.erase( it );
    }
 
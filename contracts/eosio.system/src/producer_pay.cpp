@@ -58,6 +58,11 @@ namespace eosiosystem {
 
         /// only update block producers once every minute, block_timestamp is in half seconds
         if( timestamp.slot - _gstate.last_producer_schedule_update.slot > 120 ) {
+            vote_settlement_singleton settlement( get_self(), get_self().value );
+            const uint16_t onblock_budget = settlement.get_or_default().onblock_budget;
+            if( onblock_budget > 0 ) {
+                settle_pending_votes( onblock_budget );
+            }
             update_elected_producers( timestamp );
 
             if( (timestamp.slot - _gstate.last_name_close.slot) > blocks_per_day ) {
@@ -94,18 +99,32 @@ namespace eosiosystem {
         const auto& prod = _producers.get( owner.value );
         check( prod.active(), "producer does not have an active key" );
 
+        payment_ledger_singleton ledger_singleton(get_self(), get_self().value);
+        auto ledger = ledger_singleton.get_or_default();
+        auto entry = std::lower_bound(ledger.payments.begin(), ledger.payments.end(), owner,
+            [](const payment_info& a, const name& bp) { return a.bp < bp; });
+        bool in_ledger = entry != ledger.payments.end() && entry->bp == owner;
+
+        //NOTE: rows written to the payments table before the ledger existed are paid out alongside it
         auto p = _payments.find(owner.value);
-        check(p != _payments.end(), "No payment exists for account");
-        auto prod_payment = *p;
-        auto pay_amount = prod_payment.pay;
+        check(in_ledger || p != _payments.end(), "No payment exists for account");
+
+        asset pay_amount(0, core_symbol());
+        if (in_ledger) {
+            pay_amount += entry->pay;
+            ledger.payments.erase(entry);
+            ledger_singleton.set(ledger, get_self());
+        }
+        if (p != _payments.end()) {
+            pay_amount += p->pay;
+            _payments.erase(p);
+        }
 
         //NOTE: consider resetting producer's last claim time to 0 here, instead of during snapshot.
         {
             token::transfer_action transfer_act{ token_account, { bpay_account, active_permission } };
             transfer_act.send( bpay_account, owner, pay_amount, "Producer/Standby Payment" );
         }
-
-        _payments.erase(p);
    }
 
    void system_contract::claimrewards_snapshot() {
@@ -131,37 +150,38 @@ namespace eosiosystem {
             //NOTE: This line can cause failure if eosio.tedp doesn't have a balance emplacement
             asset tedp_balance = eosio::token::get_balance(token_account, tedp_account, core_symbol().code());
             
-            int64_t transfer_tokens = 0;
-            int64_t issue_tokens = 0;
-            if (tedp_balance.amount > 0) {
-                if (tedp_balance.amount >= new_tokens) {
-                    transfer_tokens = new_tokens;
-                } else {
-                    transfer_tokens = tedp_balance.amount;
-                    issue_tokens = new_tokens - transfer_tokens; 
-                }
-            } else {
-                issue_tokens = new_tokens;
-            }
-            
-            if (transfer_tokens > 0) {
+            //NOTE: the TEDP offset is paid straight to the worker and producer accounts, filling the worker share first.
+            //      only the shortfall is issued to eosio and forwarded, so a fully offset snapshot sends two transfers.
+            int64_t offset_tokens = std::min(std::max(tedp_balance.amount, int64_t(0)), new_tokens);
+            int64_t offset_workers = std::min(offset_tokens, to_workers);
+            int64_t offset_producers = offset_tokens - offset_workers;
+            int64_t issue_tokens = new_tokens - offset_tokens;
+
+            if (offset_tokens > 0) {
                 token::transfer_action transfer_act{ token_account, { tedp_account, active_permission } };
-                transfer_act.send( tedp_account, get_self(), asset(transfer_tokens, core_symbol()), "TEDP: Inflation offset" );
-            }
 
-            token::transfer_action transfer_act{ token_account, { get_self(), active_permission } };  
+                if (offset_workers > 0) {
+                    transfer_act.send(tedp_account, works_account, asset(offset_workers, core_symbol()), "TEDP: Inflation offset");
+                }
+
+                if (offset_producers > 0) {
+                    transfer_act.send(tedp_account, bpay_account, asset(offset_producers, core_symbol()), "TEDP: Inflation offset");
+                }
+            }
 
             if (issue_tokens > 0) {
                 token::issue_action issue_action{ token_account, { get_self(), active_permission }};
                 issue_action.send(get_self(), asset(issue_tokens, core_symbol()), "Issue new TLOS tokens");
-            }
-            
-            if(to_workers > 0) {
-                transfer_act.send(get_self(), works_account, asset(to_workers, core_symbol()), "Transfer worker proposal share to works.decide account");
-            }
-            
-            if(to_producers > 0) {
-                transfer_act.send(get_self(), bpay_account, asset(to_producers, core_symbol()), "Transfer producer share to per-block bucket");
+
+                token::transfer_action transfer_act{ token_account, { get_self(), active_permission } };
+
+                if (to_workers > offset_workers) {
+                    transfer_act.send(get_self(), works_account, asset(to_workers - offset_workers, core_symbol()), "Transfer worker proposal share to works.decide account");
+                }
+
+                if (to_producers > offset_producers) {
+                    transfer_act.send(get_self(), bpay_account, asset(to_producers - offset_producers, core_symbol()), "Transfer producer share to per-block bucket");
+                }
             }
             
             _gstate.perblock_bucket += to_producers;
@@ -189,6 +209,9 @@ namespace eosiosystem {
         auto shareValue = (_gstate.perblock_bucket / sharecount);
         int32_t index = 0;
 
+        payment_ledger_singleton ledger_singleton(get_self(), get_self().value);
+        auto ledger = ledger_singleton.get_or_default();
+
         for (const auto &prod : sortedprods) {
 
             if (!prod.active()) //skip inactive producers
@@ -212,18 +235,39 @@ namespace eosiosystem {
                 p.unpaid_blocks = 0;
             });
 
-            auto itr = _payments.find(prod.owner.value);
-            
-            if (itr == _payments.end()) {
-                _payments.emplace(_self, [&]( auto& a ) { 
-                    a.bp = prod.owner;
-                    a.pay = asset(pay_amount, core_symbol());
-                });
+            auto entry = std::lower_bound(ledger.payments.begin(), ledger.payments.end(), prod.owner,
+                [](const payment_info& a, const name& bp) { return a.bp < bp; });
+
+            if (entry == ledger.payments.end() || entry->bp != prod.owner) {
+                ledger.payments.insert(entry, payment_info{ prod.owner, asset(pay_amount, core_symbol()) });
             } else //adds new payment to existing payment
-                _payments.modify(itr, same_payer, [&]( auto& a ) {
-                    a.pay += asset(pay_amount, core_symbol());
+                entry->pay += asset(pay_amount, core_symbol());
+        }
+
+        //NOTE: inactive producers can't claim, so their pay moves to a payments row until they reactivate.
+        //      this keeps the ledger bounded by the number of active producers.
+        for (auto entry = ledger.payments.begin(); entry != ledger.payments.end(); ) {
+            const auto prod = _producers.find(entry->bp.value);
+            if (prod != _producers.end() && prod->active()) {
+                ++entry;
+                continue;
+            }
+
+            auto p = _payments.find(entry->bp.value);
+            if (p == _payments.end()) {
+                _payments.emplace(get_self(), [&](auto &a) {
+                    a.bp = entry->bp;
+                    a.pay = entry->pay;
                 });
+            } else {
+                _payments.modify(p, same_payer, [&](auto &a) {
+                    a.pay += entry->pay;
+                });
+            }
+            entry = ledger.payments.erase(entry);
         }
+
+        ledger_singleton.set(ledger, get_self());
     }
 
 } //namespace eosiosystem
@@ -46,7 +46,7 @@ namespace eosiosystem {
       transfer_from_fund( from, amount );
       const asset rex_received    = add_to_rex_pool( amount );
       const asset delta_rex_stake = add_to_rex_balance( from, amount, rex_received );
-      runrex(2);
+      runrex();
       update_rex_account( from, asset( 0, core_symbol() ), delta_rex_stake );
       // dummy action added so that amount of REX tokens purchased shows up in action trace
       rex_results::buyresult_action buyrex_act( rex_account, std::vector<eosio::permission_level>{ } );
@@ -86,7 +86,7 @@ namespace eosiosystem {
       }
       const asset rex_received = add_to_rex_pool( payment );
       add_to_rex_balance( owner, payment, rex_received );
-      runrex(2);
+      runrex();
       update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ), true );
       // dummy action added so that amount of REX tokens purchased shows up in action trace
       rex_results::buyresult_action buyrex_act( rex_account, std::vector<eosio::permission_level>{ } );
@@ -97,18 +97,20 @@ namespace eosiosystem {
    {
       require_auth( from );
 
-      runrex(2);
+      runrex();
 
       auto bitr = _rexbalance.require_find( from.value, "user must first buyrex" );
       check( rex.amount > 0 && rex.symbol == bitr->rex_balance.symbol,
              "asset must be a positive amount of (REX, 4)" );
-      process_rex_maturities( bitr );
-      check( rex.amount <= bitr->matured_rex, "insufficient available rex" );
+      rex_balance rb = load_rex_balance( bitr );
+      process_rex_maturities( rb );
+      check( rex.amount <= rb.matured_rex, "insufficient available rex" );
 
-      const auto current_order = fill_rex_order( bitr, rex );
+      const auto current_order = fill_rex_order( rb, rex );
       if ( current_order.success && current_order.proceeds.amount == 0 ) {
          check( false, "proceeds are negligible" );
       }
+      put_rex_balance( bitr, rb );
       asset pending_sell_order = update_rex_account( from, current_order.proceeds, current_order.stake_change );
       if ( !current_order.success ) {
          if ( from == "b1"_n ) {
@@ -128,6 +130,7 @@ namespace eosiosystem {
                order.stake_change  = asset( 0, core_symbol() );
                order.order_time    = current_time_point();
             });
+            ++update_rex_maintenance().sell_orders;
          } else {
             _rexorders.modify( oitr, same_payer, [&]( auto& order ) {
                order.rex_requested.amount += rex.amount;
@@ -150,6 +153,8 @@ namespace eosiosystem {
       auto itr = _rexorders.require_find( owner.value, "no sellrex order is scheduled" );
       check( itr->is_open, "sellrex order has been filled and cannot be canceled" );
       _rexorders.erase( itr );
+      auto& maint = update_rex_maintenance();
+      if ( maint.sell_orders > 0 ) --maint.sell_orders;
    }
 
    void system_contract::rentcpu( const name& from, const name& receiver, const asset& loan_payment, const asset& loan_fund )
@@ -159,6 +164,7 @@ namespace eosiosystem {
       rex_cpu_loan_table cpu_loans( get_self(), get_self().value );
       int64_t rented_tokens = rent_rex( cpu_loans, from, receiver, loan_payment, loan_fund );
       update_resource_limits( from, receiver, 0, rented_tokens );
+      ++update_rex_maintenance().cpu_loans;
    }
 
    void system_contract::rentnet( const name& from, const name& receiver, const asset& loan_payment, const asset& loan_fund )
@@ -168,6 +174,7 @@ namespace eosiosystem {
       rex_net_loan_table net_loans( get_self(), get_self().value );
       int64_t rented_tokens = rent_rex( net_loans, from, receiver, loan_payment, loan_fund );
       update_resource_limits( from, receiver, rented_tokens, 0 );
+      ++update_rex_maintenance().net_loans;
    }
 
    void system_contract::fundcpuloan( const name& from, uint64_t loan_num, const asset& payment )
@@ -206,26 +213,26 @@ namespace eosiosystem {
    {
       require_auth( owner );
 
-      runrex(2);
+      runrex();
 
       auto itr = _rexbalance.require_find( owner.value, "account has no REX balance" );
       const asset init_stake = itr->vote_stake;
 
-      auto rexp_itr = _rexpool.begin();
-      const int64_t total_rex      = rexp_itr->total_rex.amount;
-      const int64_t total_lendable = rexp_itr->total_lendable.amount;
+      const auto& pool = get_rex_pool();
+      const int64_t total_rex      = pool->total_rex.amount;
+      const int64_t total_lendable = pool->total_lendable.amount;
       const int64_t rex_balance    = itr->rex_balance.amount;
 
       asset current_stake( 0, core_symbol() );
       if ( total_rex > 0 ) {
          current_stake.amount = ( uint128_t(rex_balance) * total_lendable ) / total_rex;
       }
-      _rexbalance.modify( itr, same_payer, [&]( auto& rb ) {
-         rb.vote_stake = current_stake;
-      });
+      auto rb = load_rex_balance( itr );
+      rb.vote_stake = current_stake;
+      process_rex_maturities( rb );
+      put_rex_balance( itr, rb );
 
       update_rex_account( owner, asset( 0, core_symbol() ), current_stake - init_stake, true );
-      process_rex_maturities( itr );
    }
 
    void system_contract::setrex( const asset& balance )
@@ -235,9 +242,15 @@ namespace eosiosystem {
       check( balance.amount > 0, "balance must be set to have a positive amount" );
       check( balance.symbol == core_symbol(), "balance symbol must be core symbol" );
       check( rex_system_initialized(), "rex system is not initialized" );
-      _rexpool.modify( _rexpool.begin(), same_payer, [&]( auto& pool ) {
-         pool.total_rent = balance;
-      });
+      update_rex_pool().total_rent = balance;
+   }
+
+   void system_contract::setrexbudget( uint16_t work_budget )
+   {
+      require_auth( get_self() );
+
+      check( 3 <= work_budget && work_budget <= 300, "work budget must be between 3 and 300" );
+      update_rex_maintenance().work_budget = work_budget;
    }
 
    void system_contract::rexexec( const name& user, uint16_t max )
@@ -251,67 +264,64 @@ namespace eosiosystem {
    {
       require_auth( owner );
 
-      runrex(2);
+      runrex();
 
       auto bitr = _rexbalance.require_find( owner.value, "account has no REX balance" );
       asset rex_in_sell_order = update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ) );
-      consolidate_rex_balance( bitr, rex_in_sell_order );
+      rex_balance rb = load_rex_balance( bitr );
+      consolidate_rex_balance( rb, rex_in_sell_order );
+      put_rex_balance( bitr, rb );
    }
 
    void system_contract::mvtosavings( const name& owner, const asset& rex )
    {
       require_auth( owner );
 
-      runrex(2);
+      runrex();
 
       auto bitr = _rexbalance.require_find( owner.value, "account has no REX balance" );
       check( rex.amount > 0 && rex.symbol == bitr->rex_balance.symbol, "asset must be a positive amount of (REX, 4)" );
       const asset   rex_in_sell_order = update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ) );
-      const int64_t rex_in_savings    = read_rex_savings( bitr );
-      check( rex.amount + rex_in_sell_order.amount + rex_in_savings <= bitr->rex_balance.amount,
+      rex_balance rb = load_rex_balance( bitr );
+      auto& maturities = rb.maturity_buckets.value();
+      check( rex.amount + rex_in_sell_order.amount + maturities.savings <= rb.rex_balance.amount,
              "insufficient REX balance" );
-      process_rex_maturities( bitr );
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         int64_t moved_rex = 0;
-         while ( !rb.rex_maturities.empty() && moved_rex < rex.amount) {
-            const int64_t drex = std::min( rex.amount - moved_rex, rb.rex_maturities.back().second );
-            rb.rex_maturities.back().second -= drex;
-            moved_rex                       += drex;
-            if ( rb.rex_maturities.back().second == 0 ) {
-               rb.rex_maturities.pop_back();
-            }
-         }
-         if ( moved_rex < rex.amount ) {
-            const int64_t drex = rex.amount - moved_rex;
-            rb.matured_rex    -= drex;
-            moved_rex         += drex;
-            check( rex_in_sell_order.amount <= rb.matured_rex, "logic error in mvtosavings" );
+      process_rex_maturities( rb );
+      int64_t moved_rex = 0;
+      while ( !maturities.empty() && moved_rex < rex.amount) {
+         const int64_t drex = std::min( rex.amount - moved_rex, maturities.back().second );
+         maturities.back().second -= drex;
+         moved_rex                += drex;
+         if ( maturities.back().second == 0 ) {
+            maturities.pop_back();
          }
-         check( moved_rex == rex.amount, "programmer error in mvtosavings" );
-      });
-      put_rex_savings( bitr, rex_in_savings + rex.amount );
+      }
+      if ( moved_rex < rex.amount ) {
+         const int64_t drex = rex.amount - moved_rex;
+         rb.matured_rex    -= drex;
+         moved_rex         += drex;
+         check( rex_in_sell_order.amount <= rb.matured_rex, "logic error in mvtosavings" );
+      }
+      check( moved_rex == rex.amount, "programmer error in mvtosavings" );
+      maturities.savings += rex.amount;
+      put_rex_balance( bitr, rb );
    }
 
    void system_contract::mvfrsavings( const name& owner, const asset& rex )
    {
       require_auth( owner );
 
-      runrex(2);
+      runrex();
 
       auto bitr = _rexbalance.require_find( owner.value, "account has no REX balance" );
       check( rex.amount > 0 && rex.symbol == bitr->rex_balance.symbol, "asset must be a positive amount of (REX, 4)" );
-      const int64_t rex_in_savings = read_rex_savings( bitr );
-      check( rex.amount <= rex_in_savings, "insufficient REX in savings" );
-      process_rex_maturities( bitr );
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         const time_point_sec maturity = get_rex_maturity();
-         if ( !rb.rex_maturities.empty() && rb.rex_maturities.back().first == maturity ) {
-            rb.rex_maturities.back().second += rex.amount;
-         } else {
-            rb.rex_maturities.emplace_back( maturity, rex.amount );
-         }
-      });
-      put_rex_savings( bitr, rex_in_savings - rex.amount );
+      rex_balance rb = load_rex_balance( bitr );
+      auto& maturities = rb.maturity_buckets.value();
+      check( rex.amount <= maturities.savings, "insufficient REX in savings" );
+      process_rex_maturities( rb );
+      maturities.add( get_rex_maturity(), rex.amount );
+      maturities.savings -= rex.amount;
+      put_rex_balance( bitr, rb );
       update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ) );
    }
 
@@ -320,7 +330,7 @@ namespace eosiosystem {
       require_auth( owner );
 
       if ( rex_system_initialized() )
-         runrex(2);
+         runrex();
 
       update_rex_account( owner, asset( 0, core_symbol() ), asset( 0, core_symbol() ) );
 
@@ -423,6 +433,89 @@ namespace eosiosystem {
       check( vitr != _voters.end() && ( vitr->proxy || 21 <= vitr->producers.size() ), error_msg ); 
    }
 
+   /**
+    * @brief Returns the rex pool row cached for the current action
+    *
+    * The row is read from the rex pool table on first use and is empty if the REX system
+    * has not been initialized yet.
+    */
+   const std::optional<rex_pool>& system_contract::get_rex_pool()const
+   {
+      if ( !_grexpool_loaded ) {
+         auto itr = _rexpool.begin();
+         if ( itr != _rexpool.end() ) {
+            _grexpool = *itr;
+         }
+         _grexpool_loaded = true;
+      }
+      return _grexpool;
+   }
+
+   /**
+    * @brief Returns the cached rex pool row for modification
+    *
+    * The modified row is written back to the rex pool table once, when the contract is destroyed.
+    */
+   rex_pool& system_contract::update_rex_pool()
+   {
+      check( get_rex_pool().has_value(), "rex system not initialized yet" );
+      _grexpool_dirty = true;
+      return *_grexpool;
+   }
+
+   /**
+    * @brief Writes the cached rex pool row back to the rex pool table if it was modified
+    */
+   void system_contract::put_rex_pool()
+   {
+      if ( !_grexpool_dirty ) return;
+      auto itr = _rexpool.begin();
+      if ( itr == _rexpool.end() ) {
+         _rexpool.emplace( get_self(), [&]( auto& rp ) {
+            rp = *_grexpool;
+         });
+      } else {
+         _rexpool.modify( itr, same_payer, [&]( auto& rp ) {
+            rp = *_grexpool;
+         });
+      }
+      _grexpool_dirty = false;
+   }
+
+   /**
+    * @brief Returns the rex maintenance state cached for the current action
+    */
+   const rex_maintenance_state& system_contract::get_rex_maintenance()const
+   {
+      if ( !_grexmaint_loaded ) {
+         _grexmaint = _rexmaint.get_or_default( rex_maintenance_state{} );
+         _grexmaint_loaded = true;
+      }
+      return _grexmaint;
+   }
+
+   /**
+    * @brief Returns the cached rex maintenance state for modification
+    *
+    * The modified state is written back once, when the contract is destroyed.
+    */
+   rex_maintenance_state& system_contract::update_rex_maintenance()
+   {
+      get_rex_maintenance();
+      _grexmaint_dirty = true;
+      return _grexmaint;
+   }
+
+   /**
+    * @brief Writes the cached rex maintenance state back if it was modified
+    */
+   void system_contract::put_rex_maintenance()
+   {
+      if ( !_grexmaint_dirty ) return;
+      _rexmaint.set( _grexmaint, get_self() );
+      _grexmaint_dirty = false;
+   }
+
    /**
     * @brief Checks if CPU and Network loans are available
     *
@@ -452,41 +545,19 @@ namespace eosiosystem {
     */
    void system_contract::add_loan_to_rex_pool( const asset& payment, int64_t rented_tokens, bool new_loan )
    {
-      _rexpool.modify( _rexpool.begin(), same_payer, [&]( auto& rt ) {
-         // add payment to total_rent
-         rt.total_rent.amount    += payment.amount;
-         // move rented_tokens from total_unlent to total_lent
-         rt.total_unlent.amount  -= rented_tokens;
-         rt.total_lent.amount    += rented_tokens;
-         // add payment to total_unlent
-         rt.total_unlent.amount  += payment.amount;
-         rt.total_lendable.amount = rt.total_unlent.amount + rt.total_lent.amount;
-         // increment loan_num if a new loan is being created
-         if ( new_loan ) {
-            rt.loan_num++;
-         }
-      });
-   }
-
-   /**
-    * @brief Updates rex_pool balances upon closing an expired loan
-    *
-    * @param loan - loan to be closed
-    */
-   void system_contract::remove_loan_from_rex_pool( const rex_loan& loan )
-   {
-      const auto& pool = _rexpool.begin();
-      const int64_t delta_total_rent = exchange_state::get_bancor_output( pool->total_unlent.amount,
-                                                                          pool->total_rent.amount,
-                                                                          loan.total_staked.amount );
-      _rexpool.modify( pool, same_payer, [&]( auto& rt ) {
-         // deduct calculated delta_total_rent from total_rent
-         rt.total_rent.amount    -= delta_total_rent;
-         // move rented tokens from total_lent to total_unlent
-         rt.total_unlent.amount  += loan.total_staked.amount;
-         rt.total_lent.amount    -= loan.total_staked.amount;
-         rt.total_lendable.amount = rt.total_unlent.amount + rt.total_lent.amount;
-      });
+      auto& rt = update_rex_pool();
+      // add payment to total_rent
+      rt.total_rent.amount    += payment.amount;
+      // move rented_tokens from total_unlent to total_lent
+      rt.total_unlent.amount  -= rented_tokens;
+      rt.total_lent.amount    += rented_tokens;
+      // add payment to total_unlent
+      rt.total_unlent.amount  += payment.amount;
+      rt.total_lendable.amount = rt.total_unlent.amount + rt.total_lent.amount;
+      // increment loan_num if a new loan is being created
+      if ( new_loan ) {
+         rt.loan_num++;
+      }
    }
 
    /**
@@ -505,85 +576,164 @@ namespace eosiosystem {
    }
 
    /**
-    * @brief Performs maintenance operations on expired NET and CPU loans and sellrex orders
+    * @brief Settles expired loans of one loan table as part of a batch
     *
-    * @param max - maximum number of each of the three categories to be processed
+    * Each expired loan is removed from the batch pool totals and, if it has enough balance and
+    * renting is favorable, renewed at the current price; otherwise it is closed and its remaining
+    * balance is refunded. Pool totals and resource limits are written by the caller once per batch.
+    *
+    * @param idx - loan table index ordered by expiration
+    * @param max - maximum number of loans to be settled
+    * @param cpu - whether loans are CPU loans, NET loans otherwise
+    * @param batch - batch accumulating pool totals and resource limit changes
+    *
+    * @return uint16_t - number of loans settled
     */
-   void system_contract::runrex( uint16_t max )
+   template <typename Index>
+   uint16_t system_contract::settle_expired_loans( Index& idx, uint16_t max, bool cpu, rex_loan_batch& batch )
    {
-      check( rex_system_initialized(), "rex system not initialized yet" );
-
-      const auto& pool = _rexpool.begin();
-
-      auto process_expired_loan = [&]( auto& idx, const auto& itr ) -> std::pair<bool, int64_t> {
-         /// update rex_pool in order to delete existing loan
-         remove_loan_from_rex_pool( *itr );
-         bool    delete_loan   = false;
-         int64_t delta_stake   = 0;
+      /// loan settlement does not affect sell orders or total_rex, so loan availability holds for the whole batch
+      const bool loans_available = rex_loans_available();
+      uint16_t settled = 0;
+      for ( ; settled < max; ++settled ) {
+         auto itr = idx.begin();
+         if ( itr == idx.end() || itr->expiration > current_time_point() ) break;
+
+         batch.remove_loan( *itr );
          /// calculate rented tokens at current price
-         int64_t rented_tokens = exchange_state::get_bancor_output( pool->total_rent.amount,
-                                                                    pool->total_unlent.amount,
-                                                                    itr->payment.amount );
+         const int64_t rented_tokens = exchange_state::get_bancor_output( batch.total_rent, batch.total_unlent,
+                                                                          itr->payment.amount );
          /// conditions for loan renewal
-         bool renew_loan = itr->payment <= itr->balance        /// loan has sufficient balance
-                        && itr->payment.amount < rented_tokens /// loan has favorable return
-                        && rex_loans_available();              /// no pending sell orders
+         const bool renew_loan = itr->payment <= itr->balance        /// loan has sufficient balance
+                              && itr->payment.amount < rented_tokens /// loan has favorable return
+                              && loans_available;                    /// no pending sell orders
+         int64_t delta_stake = 0;
          if ( renew_loan ) {
-            /// update rex_pool in order to account for renewed loan
-            add_loan_to_rex_pool( itr->payment, rented_tokens, false );
-            /// update renewed loan fields
+            batch.add_loan( itr->payment.amount, rented_tokens );
             delta_stake = update_renewed_loan( idx, itr, rented_tokens );
          } else {
-            delete_loan = true;
             delta_stake = -( itr->total_staked.amount );
             /// refund "from" account if the closed loan balance is positive
             if ( itr->balance.amount > 0 ) {
                transfer_to_fund( itr->from, itr->balance );
             }
          }
+         if ( delta_stake != 0 ) {
+            batch.add_resource_delta( itr->from, itr->receiver, cpu ? 0 : delta_stake, cpu ? delta_stake : 0 );
+         }
+
+         if ( !renew_loan ) {
+            idx.erase( itr );
+            auto& maint = update_rex_maintenance();
+            if ( cpu ) {
+               if ( maint.cpu_loans > 0 ) --maint.cpu_loans;
+            } else {
+               if ( maint.net_loans > 0 ) --maint.net_loans;
+            }
+         }
+      }
+      return settled;
+   }
+
+   /**
+    * @brief Performs maintenance operations on expired NET and CPU loans and sellrex orders
+    *
+    * @param max - maximum number of each of the three categories to be processed
+    */
+   void system_contract::runrex( uint16_t max )
+   {
+      process_rex_queues( { max, max, max } );
+   }
+
+   /**
+    * @brief Performs maintenance operations within the configured work budget
+    *
+    * The work budget is split across expired CPU loans, expired NET loans and sellrex orders
+    * by queue depth. Sell orders are given whatever the loan queues leave of the budget, and
+    * budget still left after that goes to the loan queues that used up their share.
+    */
+   void system_contract::runrex()
+   {
+      const uint16_t budget = get_rex_maintenance().work_budget;
+      const rex_queue_counts shares = split_rex_budget( budget, get_rex_maintenance() );
+
+      const rex_queue_counts loans = process_rex_queues( { shares.cpu_loans, shares.net_loans, 0 } );
+      uint16_t left = budget - loans.total();
+      left -= process_rex_queues( { 0, 0, left } ).total();
+      if ( left > 0 && loans.cpu_loans == shares.cpu_loans ) {
+         left -= process_rex_queues( { left, 0, 0 } ).total();
+      }
+      if ( left > 0 && loans.net_loans == shares.net_loans ) {
+         process_rex_queues( { 0, left, 0 } );
+      }
+   }
+
+   /**
+    * @brief Splits a maintenance work budget across REX queues by queue depth
+    *
+    * Every queue weighs at least one, so that loans and orders opened before queue depths
+    * were tracked are still processed.
+    *
+    * @param budget - number of queue items to be processed
+    * @param maint - rex maintenance state holding queue depths
+    *
+    * @return rex_queue_counts - maximum number of items to be processed from each queue
+    */
+   rex_queue_counts system_contract::split_rex_budget( uint16_t budget, const rex_maintenance_state& maint )
+   {
+      const uint64_t cpu_weight   = uint64_t(maint.cpu_loans) + 1;
+      const uint64_t net_weight   = uint64_t(maint.net_loans) + 1;
+      const uint64_t order_weight = uint64_t(maint.sell_orders) + 1;
+      const uint64_t total_weight = cpu_weight + net_weight + order_weight;
+
+      rex_queue_counts shares;
+      shares.cpu_loans   = ( budget * cpu_weight ) / total_weight;
+      shares.net_loans   = ( budget * net_weight ) / total_weight;
+      shares.sell_orders = budget - shares.cpu_loans - shares.net_loans;
+      return shares;
+   }
+
+   /**
+    * @brief Processes expired NET and CPU loans and sellrex orders
+    *
+    * @param max - maximum number of items of each of the three queues to be processed
+    *
+    * @return rex_queue_counts - number of items processed from each queue
+    */
+   rex_queue_counts system_contract::process_rex_queues( const rex_queue_counts& max )
+   {
+      check( rex_system_initialized(), "rex system not initialized yet" );
 
-         return { delete_loan, delta_stake };
-      };
+      const auto& pool = get_rex_pool();
+      rex_queue_counts processed;
 
       /// transfer from eosio.names to eosio.rex
       if ( pool->namebid_proceeds.amount > 0 ) {
          channel_to_rex( names_account, pool->namebid_proceeds );
-         _rexpool.modify( pool, same_payer, [&]( auto& rt ) {
-            rt.namebid_proceeds.amount = 0;
-         });
+         update_rex_pool().namebid_proceeds.amount = 0;
       }
 
-      /// process cpu loans
+      /// process cpu and net loans, settling them as one batch against the rex pool and resource limits
       {
+         rex_loan_batch batch{ pool->total_rent.amount, pool->total_unlent.amount, pool->total_lent.amount };
+
          rex_cpu_loan_table cpu_loans( get_self(), get_self().value );
          auto cpu_idx = cpu_loans.get_index<"byexpr"_n>();
-         for ( uint16_t i = 0; i < max; ++i ) {
-            auto itr = cpu_idx.begin();
-            if ( itr == cpu_idx.end() || itr->expiration > current_time_point() ) break;
+         processed.cpu_loans = settle_expired_loans( cpu_idx, max.cpu_loans, true, batch );
 
-            auto result = process_expired_loan( cpu_idx, itr );
-            if ( result.second != 0 )
-               update_resource_limits( itr->from, itr->receiver, 0, result.second );
-
-            if ( result.first )
-               cpu_idx.erase( itr );
-         }
-      }
-
-      /// process net loans
-      {
          rex_net_loan_table net_loans( get_self(), get_self().value );
          auto net_idx = net_loans.get_index<"byexpr"_n>();
-         for ( uint16_t i = 0; i < max; ++i ) {
-            auto itr = net_idx.begin();
-            if ( itr == net_idx.end() || itr->expiration > current_time_point() ) break;
-
-            auto result = process_expired_loan( net_idx, itr );
-            if ( result.second != 0 )
-               update_resource_limits( itr->from, itr->receiver, result.second, 0 );
-
-            if ( result.first )
-               net_idx.erase( itr );
+         processed.net_loans = settle_expired_loans( net_idx, max.net_loans, false, batch );
+
+         if ( batch.settled > 0 ) {
+            auto& rt = update_rex_pool();
+            rt.total_rent.amount     = batch.total_rent;
+            rt.total_unlent.amount   = batch.total_unlent;
+            rt.total_lent.amount     = batch.total_lent;
+            rt.total_lendable.amount = rt.total_unlent.amount + rt.total_lent.amount;
+         }
+         for ( const auto& [receiver, delta] : batch.resource_deltas ) {
+            update_resource_limits( delta.from, receiver, delta.net, delta.cpu );
          }
       }
 
@@ -591,20 +741,24 @@ namespace eosiosystem {
       if ( _rexorders.begin() != _rexorders.end() ) {
          auto idx  = _rexorders.get_index<"bytime"_n>();
          auto oitr = idx.begin();
-         for ( uint16_t i = 0; i < max; ++i ) {
+         for ( ; processed.sell_orders < max.sell_orders; ++processed.sell_orders ) {
             if ( oitr == idx.end() || !oitr->is_open ) break;
             auto next = oitr;
             ++next;
             auto bitr = _rexbalance.find( oitr->owner.value );
             if ( bitr != _rexbalance.end() ) { // should always be true
-               auto result = fill_rex_order( bitr, oitr->rex_requested );
+               rex_balance rb = load_rex_balance( bitr );
+               auto result = fill_rex_order( rb, oitr->rex_requested );
                if ( result.success ) {
+                  put_rex_balance( bitr, rb );
                   const name order_owner = oitr->owner;
                   idx.modify( oitr, same_payer, [&]( auto& order ) {
                      order.proceeds.amount     = result.proceeds.amount;
                      order.stake_change.amount = result.stake_change.amount;
                      order.close();
                   });
+                  auto& maint = update_rex_maintenance();
+                  if ( maint.sell_orders > 0 ) --maint.sell_orders;
                   /// send dummy action to show owner and proceeds of filled sellrex order
                   rex_results::orderresult_action order_act( rex_account, std::vector<eosio::permission_level>{ } );
                   order_act.send( order_owner, result.proceeds );
@@ -614,6 +768,10 @@ namespace eosiosystem {
          }
       }
 
+      if ( processed.total() > 0 ) {
+         update_rex_maintenance().processed += processed.total();
+      }
+      return processed;
    }
 
    // void system_contract::rexlimit( double limit ) {  
@@ -688,7 +846,7 @@ namespace eosiosystem {
    template <typename T>
    int64_t system_contract::rent_rex( T& table, const name& from, const name& receiver, const asset& payment, const asset& fund )
    {
-      runrex(2);
+      runrex();
 
       check( rex_loans_available(), "rex loans are currently not available" );
       check( payment.symbol == core_symbol() && fund.symbol == core_symbol(), "must use core token" );
@@ -696,7 +854,7 @@ namespace eosiosystem {
 
       transfer_from_fund( from, payment + fund );
 
-      const auto& pool = _rexpool.begin(); /// already checked that _rexpool.begin() != _rexpool.end() in rex_loans_available()
+      const auto& pool = get_rex_pool(); /// already checked that the rex pool exists in rex_loans_available()
 
       int64_t rented_tokens = exchange_state::get_bancor_output( pool->total_rent.amount,
                                                                  pool->total_unlent.amount,
@@ -775,17 +933,19 @@ namespace eosiosystem {
     * different function to complete order processing, i.e. transfer proceeds to user REX fund and
     * update user vote weight.
     *
-    * @param bitr - iterator pointing to rex_balance database record
+    * @param rb - working copy of owner rex_balance object, written back by the caller
     * @param rex - amount of rex to be sold
     *
     * @return rex_order_outcome - a struct containing success flag, order proceeds, and resultant
     * vote stake change
     */
-   rex_order_outcome system_contract::fill_rex_order( const rex_balance_table::const_iterator& bitr, const asset& rex )
+   rex_order_outcome system_contract::fill_rex_order( rex_balance& rb, const asset& rex )
    {
-      auto rexitr = _rexpool.begin();
-      const int64_t S0 = rexitr->total_lendable.amount;
-      const int64_t R0 = rexitr->total_rex.amount;
+      /// the pool is only marked for writing once the order is known to fill
+      const auto& pool = get_rex_pool();
+      check( pool.has_value(), "rex system not initialized yet" );
+      const int64_t S0 = pool->total_lendable.amount;
+      const int64_t R0 = pool->total_rex.amount;
       const int64_t p  = (uint128_t(rex.amount) * S0) / R0;
       const int64_t R1 = R0 - rex.amount;
       const int64_t S1 = S0 - p;
@@ -793,22 +953,19 @@ namespace eosiosystem {
       asset stake_change( 0, core_symbol() );
       bool  success = false;
 
-      const int64_t unlent_lower_bound = ( uint128_t(2) * rexitr->total_lent.amount ) / 10;
-      const int64_t available_unlent   = rexitr->total_unlent.amount - unlent_lower_bound; // available_unlent <= 0 is possible
+      const int64_t unlent_lower_bound = ( uint128_t(2) * pool->total_lent.amount ) / 10;
+      const int64_t available_unlent   = pool->total_unlent.amount - unlent_lower_bound; // available_unlent <= 0 is possible
       if ( proceeds.amount <= available_unlent ) {
-         const int64_t init_vote_stake_amount = bitr->vote_stake.amount;
-         const int64_t current_stake_value    = ( uint128_t(bitr->rex_balance.amount) * S0 ) / R0;
-         _rexpool.modify( rexitr, same_payer, [&]( auto& rt ) {
-            rt.total_rex.amount      = R1;
-            rt.total_lendable.amount = S1;
-            rt.total_unlent.amount   = rt.total_lendable.amount - rt.total_lent.amount;
-         });
-         _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-            rb.vote_stake.amount   = current_stake_value - proceeds.amount;
-            rb.rex_balance.amount -= rex.amount;
-            rb.matured_rex        -= rex.amount;
-         });
-         stake_change.amount = bitr->vote_stake.amount - init_vote_stake_amount;
+         auto& rt = update_rex_pool();
+         const int64_t init_vote_stake_amount = rb.vote_stake.amount;
+         const int64_t current_stake_value    = ( uint128_t(rb.rex_balance.amount) * S0 ) / R0;
+         rt.total_rex.amount      = R1;
+         rt.total_lendable.amount = S1;
+         rt.total_unlent.amount   = rt.total_lendable.amount - rt.total_lent.amount;
+         rb.vote_stake.amount   = current_stake_value - proceeds.amount;
+         rb.rex_balance.amount -= rex.amount;
+         rb.matured_rex        -= rex.amount;
+         stake_change.amount = rb.vote_stake.amount - init_vote_stake_amount;
          success = true;
       } else {
          proceeds.amount = 0;
@@ -933,10 +1090,9 @@ namespace eosiosystem {
    {
 #if CHANNEL_RAM_AND_NAMEBID_FEES_TO_REX
       if ( rex_available() ) {
-         _rexpool.modify( _rexpool.begin(), same_payer, [&]( auto& rp ) {
-            rp.total_unlent.amount   += amount.amount;
-            rp.total_lendable.amount += amount.amount;
-         });
+         auto& rp = update_rex_pool();
+         rp.total_unlent.amount   += amount.amount;
+         rp.total_lendable.amount += amount.amount;
          // inline transfer to rex_account
          token::transfer_action transfer_act{ token_account, { from, active_permission } };
          transfer_act.send( from, rex_account, amount,
@@ -954,9 +1110,7 @@ namespace eosiosystem {
    {
 #if CHANNEL_RAM_AND_NAMEBID_FEES_TO_REX
       if ( rex_available() ) {
-         _rexpool.modify( _rexpool.begin(), same_payer, [&]( auto& rp ) {
-            rp.namebid_proceeds.amount += highest_bid;
-         });
+         update_rex_pool().namebid_proceeds.amount += highest_bid;
       }
 #endif
    }
@@ -979,41 +1133,36 @@ namespace eosiosystem {
    /**
     * @brief Updates REX owner maturity buckets
     *
-    * @param bitr - iterator pointing to rex_balance object
+    * @param rb - working copy of owner rex_balance object
     */
-   void system_contract::process_rex_maturities( const rex_balance_table::const_iterator& bitr )
+   void system_contract::process_rex_maturities( rex_balance& rb )
    {
       const time_point_sec now = current_time_point();
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         while ( !rb.rex_maturities.empty() && rb.rex_maturities.front().first <= now ) {
-            rb.matured_rex += rb.rex_maturities.front().second;
-            rb.rex_maturities.pop_front();
-         }
-      });
+      auto& maturities = rb.maturity_buckets.value();
+      while ( !maturities.empty() && maturities.front().first <= now ) {
+         rb.matured_rex += maturities.front().second;
+         maturities.pop_front();
+      }
    }
 
    /**
     * @brief Consolidates REX maturity buckets into one
     *
-    * @param bitr - iterator pointing to rex_balance object
+    * @param rb - working copy of owner rex_balance object
     * @param rex_in_sell_order - REX tokens in owner unfilled sell order, if one exists
     */
-   void system_contract::consolidate_rex_balance( const rex_balance_table::const_iterator& bitr,
-                                                  const asset& rex_in_sell_order )
+   void system_contract::consolidate_rex_balance( rex_balance& rb, const asset& rex_in_sell_order )
    {
-      const int64_t rex_in_savings = read_rex_savings( bitr );
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         int64_t total  = rb.matured_rex - rex_in_sell_order.amount;
-         rb.matured_rex = rex_in_sell_order.amount;
-         while ( !rb.rex_maturities.empty() ) {
-            total += rb.rex_maturities.front().second;
-            rb.rex_maturities.pop_front();
-         }
-         if ( total > 0 ) {
-            rb.rex_maturities.emplace_back( get_rex_maturity(), total );
-         }
-      });
-      put_rex_savings( bitr, rex_in_savings );
+      auto& maturities = rb.maturity_buckets.value();
+      int64_t total  = rb.matured_rex - rex_in_sell_order.amount;
+      rb.matured_rex = rex_in_sell_order.amount;
+      while ( !maturities.empty() ) {
+         total += maturities.front().second;
+         maturities.pop_front();
+      }
+      if ( total > 0 ) {
+         maturities.add( get_rex_maturity(), total );
+      }
    }
 
    /**
@@ -1036,41 +1185,38 @@ namespace eosiosystem {
       const int64_t rex_ratio = 10000;
       const asset   init_total_rent( 20'000'0000, core_symbol() ); /// base balance prevents renting profitably until at least a minimum number of core_symbol() is made available
       asset rex_received( 0, rex_symbol );
-      auto itr = _rexpool.begin();
       if ( !rex_system_initialized() ) {
-         /// initialize REX pool
-         _rexpool.emplace( get_self(), [&]( auto& rp ) {
-            rex_received.amount = payment.amount * rex_ratio;
-            rp.total_lendable   = payment;
-            rp.total_lent       = asset( 0, core_symbol() );
-            rp.total_unlent     = rp.total_lendable - rp.total_lent;
-            rp.total_rent       = init_total_rent;
-            rp.total_rex        = rex_received;
-            rp.namebid_proceeds = asset( 0, core_symbol() );
-         });
+         /// initialize REX pool, the row is created when the cached pool is written back
+         _grexpool.emplace();
+         auto& rp = update_rex_pool();
+         rex_received.amount = payment.amount * rex_ratio;
+         rp.total_lendable   = payment;
+         rp.total_lent       = asset( 0, core_symbol() );
+         rp.total_unlent     = rp.total_lendable - rp.total_lent;
+         rp.total_rent       = init_total_rent;
+         rp.total_rex        = rex_received;
+         rp.namebid_proceeds = asset( 0, core_symbol() );
       } else if ( !rex_available() ) { /// should be a rare corner case, REX pool is initialized but empty
-         _rexpool.modify( itr, same_payer, [&]( auto& rp ) {
-            rex_received.amount      = payment.amount * rex_ratio;
-            rp.total_lendable.amount = payment.amount;
-            rp.total_lent.amount     = 0;
-            rp.total_unlent.amount   = rp.total_lendable.amount - rp.total_lent.amount;
-            rp.total_rent.amount     = init_total_rent.amount;
-            rp.total_rex.amount      = rex_received.amount;
-         });
+         auto& rp = update_rex_pool();
+         rex_received.amount      = payment.amount * rex_ratio;
+         rp.total_lendable.amount = payment.amount;
+         rp.total_lent.amount     = 0;
+         rp.total_unlent.amount   = rp.total_lendable.amount - rp.total_lent.amount;
+         rp.total_rent.amount     = init_total_rent.amount;
+         rp.total_rex.amount      = rex_received.amount;
       } else {
+         auto& rp = update_rex_pool();
          /// total_lendable > 0 if total_rex > 0 except in a rare case and due to rounding errors
-         check( itr->total_lendable.amount > 0, "lendable REX pool is empty" );
-         const int64_t S0 = itr->total_lendable.amount;
+         check( rp.total_lendable.amount > 0, "lendable REX pool is empty" );
+         const int64_t S0 = rp.total_lendable.amount;
          const int64_t S1 = S0 + payment.amount;
-         const int64_t R0 = itr->total_rex.amount;
+         const int64_t R0 = rp.total_rex.amount;
          const int64_t R1 = (uint128_t(S1) * R0) / S0;
          rex_received.amount = R1 - R0;
-         _rexpool.modify( itr, same_payer, [&]( auto& rp ) {
-            rp.total_lendable.amount = S1;
-            rp.total_rex.amount      = R1;
-            rp.total_unlent.amount   = rp.total_lendable.amount - rp.total_lent.amount;
-            check( rp.total_unlent.amount >= 0, "programmer error, this should never go negative" );
-         });
+         rp.total_lendable.amount = S1;
+         rp.total_rex.amount      = R1;
+         rp.total_unlent.amount   = rp.total_lendable.amount - rp.total_lent.amount;
+         check( rp.total_unlent.amount >= 0, "programmer error, this should never go negative" );
       }
 
       return rex_received;
@@ -1091,76 +1237,76 @@ namespace eosiosystem {
       asset current_rex_stake( 0, core_symbol() );
       auto bitr = _rexbalance.find( owner.value );
       if ( bitr == _rexbalance.end() ) {
-         bitr = _rexbalance.emplace( owner, [&]( auto& rb ) {
+         _rexbalance.emplace( owner, [&]( auto& rb ) {
             rb.owner       = owner;
             rb.vote_stake  = payment;
             rb.rex_balance = rex_received;
+            rb.version     = 1;
+            rb.maturity_buckets.emplace().add( get_rex_maturity(), rex_received.amount );
          });
          current_rex_stake.amount = payment.amount;
-      } else {
-         init_rex_stake.amount = bitr->vote_stake.amount;
-         _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-            rb.rex_balance.amount += rex_received.amount;
-            rb.vote_stake.amount   = ( uint128_t(rb.rex_balance.amount) * _rexpool.begin()->total_lendable.amount )
-                                     / _rexpool.begin()->total_rex.amount;
-         });
-         current_rex_stake.amount = bitr->vote_stake.amount;
+         return current_rex_stake - init_rex_stake;
       }
 
-      const int64_t rex_in_savings = read_rex_savings( bitr );
-      process_rex_maturities( bitr );
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         const time_point_sec maturity = get_rex_maturity();
-         if ( !rb.rex_maturities.empty() && rb.rex_maturities.back().first == maturity ) {
-            rb.rex_maturities.back().second += rex_received.amount;
-         } else {
-            rb.rex_maturities.emplace_back( maturity, rex_received.amount );
-         }
-      });
-      put_rex_savings( bitr, rex_in_savings );
+      rex_balance rb = load_rex_balance( bitr );
+      init_rex_stake.amount  = rb.vote_stake.amount;
+      rb.rex_balance.amount += rex_received.amount;
+      rb.vote_stake.amount   = ( uint128_t(rb.rex_balance.amount) * get_rex_pool()->total_lendable.amount )
+                               / get_rex_pool()->total_rex.amount;
+      current_rex_stake.amount = rb.vote_stake.amount;
+
+      process_rex_maturities( rb );
+      rb.maturity_buckets.value().add( get_rex_maturity(), rex_received.amount );
+      put_rex_balance( bitr, rb );
       return current_rex_stake - init_rex_stake;
    }
 
    /**
-    * @brief Reads amount of REX in savings bucket and removes the bucket from maturities
+    * @brief Reads a working copy of a rex_balance object
     *
-    * Reads and (temporarily) removes REX savings bucket from REX maturities in order to
-    * allow uniform processing of remaining buckets as savings is a special case. This
-    * function is used in conjunction with put_rex_savings.
+    * Rows written before version 1 keep their maturity buckets, including the savings bucket,
+    * in the `rex_maturities` deque. Such rows are moved to `maturity_buckets` the first
+    * time they are touched; the migrated layout is stored by the following put_rex_balance.
     *
     * @param bitr - iterator pointing to rex_balance object
     *
-    * @return int64_t - amount of REX in savings bucket
+    * @return rex_balance - working copy using maturity_buckets
     */
-   int64_t system_contract::read_rex_savings( const rex_balance_table::const_iterator& bitr )
+   rex_balance system_contract::load_rex_balance( const rex_balance_table::const_iterator& bitr )
    {
-      int64_t rex_in_savings = 0;
-      static const time_point_sec end_of_days = time_point_sec::maximum();
-      if ( !bitr->rex_maturities.empty() && bitr->rex_maturities.back().first == end_of_days ) {
-         _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-            rex_in_savings = rb.rex_maturities.back().second;
-            rb.rex_maturities.pop_back();
-         });
+      rex_balance rb = *bitr;
+      if ( rb.version == 0 ) {
+         static const time_point_sec end_of_days = time_point_sec::maximum();
+         const time_point_sec now = current_time_point();
+         auto& maturities = rb.maturity_buckets.emplace();
+         for ( const auto& m : rb.rex_maturities ) {
+            if ( m.first == end_of_days ) {
+               maturities.savings += m.second;
+            } else if ( m.first <= now ) {
+               rb.matured_rex += m.second;
+            } else {
+               maturities.add( m.first, m.second );
+            }
+         }
+         rb.rex_maturities.clear();
+         rb.version = 1;
       }
-      return rex_in_savings;
+      return rb;
    }
 
    /**
-    * @brief Adds a specified REX amount to savings bucket
+    * @brief Writes a working copy of a rex_balance object back to the rex balance table
+    *
+    * REX balance helpers operate on an in-memory copy of the owner row so that an action
+    * serializes the row, including its maturity buckets, only once.
     *
     * @param bitr - iterator pointing to rex_balance object
-    * @param rex - amount of REX to be added
+    * @param rb - working copy to be stored
     */
-   void system_contract::put_rex_savings( const rex_balance_table::const_iterator& bitr, int64_t rex )
+   void system_contract::put_rex_balance( const rex_balance_table::const_iterator& bitr, const rex_balance& rb )
    {
-      if ( rex == 0 ) return;
-      static const time_point_sec end_of_days = time_point_sec::maximum();
-      _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
-         if ( !rb.rex_maturities.empty() && rb.rex_maturities.back().first == end_of_days ) {
-            rb.rex_maturities.back().second += rex;
-         } else {
-            rb.rex_maturities.emplace_back( end_of_days, rex );
-         }
+      _rexbalance.modify( bitr, same_payer, [&]( auto& r ) {
+         r = rb;
       });
    }
 
@@ -1176,8 +1322,8 @@ namespace eosiosystem {
       if ( bitr != _rexbalance.end() && rex_available() ) {
          asset init_vote_stake = bitr->vote_stake;
          asset current_vote_stake( 0, core_symbol() );
-         current_vote_stake.amount = ( uint128_t(bitr->rex_balance.amount) * _rexpool.begin()->total_lendable.amount )
-                                     / _rexpool.begin()->total_rex.amount;
+         current_vote_stake.amount = ( uint128_t(bitr->rex_balance.amount) * get_rex_pool()->total_lendable.amount )
+                                     / get_rex_pool()->total_rex.amount;
          _rexbalance.modify( bitr, same_payer, [&]( auto& rb ) {
             rb.vote_stake.amount = current_vote_stake.amount;
          });
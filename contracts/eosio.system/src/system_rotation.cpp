@@ -29,47 +29,57 @@ void system_contract::update_missed_blocks_per_rotation() {
                     _gschedule_metrics.producers_metric.end());
   uint16_t max_kick_bps = uint16_t(active_schedule_size / 7);
 
-  std::vector<producer_info> prods;
+  // sort keys only, rows are reached through the iterator
+  struct missed_entry {
+    uint32_t missed;
+    double total_votes;
+    uint32_t added;
+    producers_table::const_iterator pitr;
+    bool kicked;
+  };
+  std::vector<missed_entry> prods;
+  prods.reserve(_gschedule_metrics.producers_metric.size());
 
   for (auto &pm : _gschedule_metrics.producers_metric) {
     auto pitr = _producers.find(pm.bp_name.value);
     if (pitr != _producers.end() && pitr->is_active) {
-      if (pm.missed_blocks_per_cycle > 0) {
-        //  print("\nblock producer: ", name{pm.name}, " missed ",
-        //  pm.missed_blocks_per_cycle, " blocks.");
-        _producers.modify(pitr, same_payer, [&](auto &p) {
-          p.missed_blocks_per_rotation += pm.missed_blocks_per_cycle;
-          //   print("\ntotal missed blocks: ", p.missed_blocks_per_rotation);
-        });
-      }
-
-      if (pitr->missed_blocks_per_rotation > 0)
-        prods.emplace_back(*pitr);
+      uint32_t missed = pitr->missed_blocks_per_rotation + pm.missed_blocks_per_cycle;
+      if (missed > 0)
+        prods.push_back(missed_entry{missed, pitr->total_votes, pm.missed_blocks_per_cycle, pitr, false});
     }
   }
 
-  std::sort(prods.begin(), prods.end(), [](const producer_info &p1,
-                                           const producer_info &p2) {
-    if (p1.missed_blocks_per_rotation != p2.missed_blocks_per_rotation)
-      return p1.missed_blocks_per_rotation > p2.missed_blocks_per_rotation;
+  std::sort(prods.begin(), prods.end(), [](const missed_entry &p1,
+                                           const missed_entry &p2) {
+    if (p1.missed != p2.missed)
+      return p1.missed > p2.missed;
     else
       return p1.total_votes < p2.total_votes;
   });
 
   for (auto &prod : prods) {
-    auto pitr = _producers.find(prod.owner.value);
-
-    if (crossed_missed_blocks_threshold(pitr->missed_blocks_per_rotation,
+    if (crossed_missed_blocks_threshold(prod.missed,
                                         uint32_t(active_schedule_size)) &&
         max_kick_bps > 0) {
-      _producers.modify(pitr, same_payer, [&](auto &p) {
-        p.lifetime_missed_blocks += p.missed_blocks_per_rotation;
-        p.kick(kick_type::REACHED_TRESHOLD);
-      });
+      prod.kicked = true;
       max_kick_bps--;
     } else
       break;
   }
+
+  // one write per producer covering both the new missed blocks and the kick
+  for (const auto &prod : prods) {
+    if (prod.added == 0 && !prod.kicked)
+      continue;
+
+    _producers.modify(prod.pitr, same_payer, [&](auto &p) {
+      p.missed_blocks_per_rotation += prod.added;
+      if (prod.kicked) {
+        p.lifetime_missed_blocks += p.missed_blocks_per_rotation;
+        p.kick(kick_type::REACHED_TRESHOLD);
+      }
+    });
+  }
 }
 
 void system_contract::restart_missed_blocks_per_rotation(
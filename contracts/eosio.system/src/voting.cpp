@@ -102,10 +102,19 @@ namespace eosiosystem {
       /// sort by producer name
       std::sort( top_producers.begin(), top_producers.end() );
 
+      /// nothing to propose if the schedule matches the last one proposed
+      auto packed_schedule = eosio::pack( top_producers );
+      auto schedule_hash = eosio::sha256( packed_schedule.data(), packed_schedule.size() );
+      if( _grotation.last_proposed_hash.has_value() && _grotation.last_proposed_hash.value() == schedule_hash ) {
+         return;
+      }
+
       auto schedule_version = set_proposed_producers(top_producers);
       if (schedule_version >= 0) {
         print("\n**new schedule was proposed**");
         
+        /// only a schedule the chain accepted counts as proposed, a rejected one is retried next update
+        _grotation.last_proposed_hash.emplace( schedule_hash );
         _gstate.last_proposed_schedule_update = block_time;
 
         _gschedule_metrics.producers_metric.erase( _gschedule_metrics.producers_metric.begin(), _gschedule_metrics.producers_metric.end());
@@ -140,6 +149,7 @@ namespace eosiosystem {
       require_auth( voter_name );
       vote_stake_updater( voter_name );
       update_votes( voter_name, proxy, producers, true );
+      erase_pending_vote( voter_name, false );
       // auto rex_itr = _rexbalance.find( voter_name.value );            Remove requirement to vote 21 BPs or select a proxy to stake to REX
       // if( rex_itr != _rexbalance.end() && rex_itr->rex_balance.amount > 0 ) {
       //    check_voting_requirement( voter_name, "voter holding REX tokens must vote for at least 21 producers or for a proxy" );
@@ -282,6 +292,66 @@ namespace eosiosystem {
       }
    }
 
+   void system_contract::setlazyvotes( const name& voter, bool enabled ) {
+      require_auth( voter );
+
+      auto vitr = _voters.find( voter.value );
+      check( vitr != _voters.end(), "user must stake before they can change vote settlement" );
+      check( enabled != has_field( vitr->flags1, voter_info::flags1_fields::lazy_votes ), "action has no effect" );
+
+      _voters.modify( vitr, same_payer, [&]( auto& v ) {
+         v.flags1 = set_field( v.flags1, voter_info::flags1_fields::lazy_votes, enabled );
+      });
+
+      if( !enabled ) {
+         erase_pending_vote( voter, true );
+      }
+   }
+
+   void system_contract::settlevotes( uint16_t max ) {
+      check( max > 0, "max must be positive" );
+      check( settle_pending_votes( max ) > 0, "no pending votes to settle" );
+   }
+
+   void system_contract::setsettlemax( uint16_t onblock_budget ) {
+      require_auth( get_self() );
+      check( onblock_budget <= max_vote_settlements, "onblock budget exceeds max_vote_settlements" );
+
+      vote_settlement_singleton settlement( get_self(), get_self().value );
+      settlement.set( vote_settlement_state{ onblock_budget }, get_self() );
+   }
+
+   void system_contract::erase_pending_vote( const name& voter, bool settle ) {
+      pending_votes_table pending( get_self(), get_self().value );
+      auto owner_index = pending.get_index<"byowner"_n>();
+      auto pitr = owner_index.find( voter.value );
+      if( pitr == owner_index.end() ) {
+         return;
+      }
+
+      if( settle ) {
+         const auto& v = _voters.get( voter.value, "user must stake before they can change vote settlement" );
+         update_votes( voter, v.proxy, v.producers, false );
+      }
+      owner_index.erase( pitr );
+   }
+
+   uint16_t system_contract::settle_pending_votes( uint16_t max ) {
+      pending_votes_table pending( get_self(), get_self().value );
+
+      uint16_t settled = 0;
+      for( auto pitr = pending.begin(); pitr != pending.end() && settled < max; ++settled ) {
+         auto vitr = _voters.find( pitr->owner.value );
+         /// voters that dropped their producers since queueing have nothing left to settle
+         if( vitr != _voters.end() && vitr->producers.size() ) {
+            update_votes( vitr->owner, vitr->proxy, vitr->producers, false );
+         }
+         pitr = pending.erase( pitr );
+      }
+
+      return settled;
+   }
+
    void system_contract::propagate_weight_change( const voter_info& voter ) {
       check( voter.proxy == name(0) || !voter.is_proxy, "account registered as a proxy is not allowed to use a proxy");
       
@@ -4,6 +4,7 @@
 #include <eosio/eosio.hpp>
 
 #include <string>
+#include <vector>
 
 namespace eosiosystem {
    class system_contract;
@@ -12,6 +13,7 @@ namespace eosiosystem {
 namespace eosio {
 
    using std::string;
+   using std::vector;
 
    /**
     * The `eosio.token` sample system contract defines the structures and actions that allow users to create, issue, and manage tokens for EOSIO based blockchains. It demonstrates one way to implement a smart contract which allows for creation and management of tokens. It is possible for one to create a similar contract which suits different needs. However, it is recommended that if one only needs a token with the below listed actions, that one uses the `eosio.token` contract instead of developing their own.
@@ -74,6 +76,25 @@ namespace eosio {
                         const name&    to,
                         const asset&   quantity,
                         const string&  memo );
+
+         /**
+          * Allows `from` account to transfer tokens of a single symbol to several accounts at once.
+          * `from` is debited once with the sum of all quantities and every recipient is credited with its quantity.
+          * `from` and every recipient are notified of the `transfermany` action, not of `transfer`.
+          * Contracts that only handle `transfer` notifications will not see these payments.
+          *
+          * @param from - the account to transfer from,
+          * @param transfers - the recipient accounts and the quantities they receive,
+          * @param memo - the memo string to accompany the transaction.
+          *
+          * @pre All quantities must be positive and share the same symbol,
+          * @pre `from` must not be one of the recipients.
+          */
+         [[eosio::action]]
+         void transfermany( const name&                          from,
+                            const vector<std::pair<name, asset>>& transfers,
+                            const string&                        memo );
+
          /**
           * Allows `ram_payer` to create an account `owner` with zero balance for
           * token `symbol` at the expense of `ram_payer`.
@@ -119,6 +140,7 @@ namespace eosio {
          using issue_action = eosio::action_wrapper<"issue"_n, &token::issue>;
          using retire_action = eosio::action_wrapper<"retire"_n, &token::retire>;
          using transfer_action = eosio::action_wrapper<"transfer"_n, &token::transfer>;
+         using transfermany_action = eosio::action_wrapper<"transfermany"_n, &token::transfermany>;
          using open_action = eosio::action_wrapper<"open"_n, &token::open>;
          using close_action = eosio::action_wrapper<"close"_n, &token::close>;
       private:
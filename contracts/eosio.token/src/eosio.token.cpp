@@ -100,6 +100,41 @@ void token::transfer( const name&    from,
     add_balance( to, quantity, payer );
 }
 
+void token::transfermany( const name&                          from,
+                          const vector<std::pair<name, asset>>& transfers,
+                          const string&                        memo )
+{
+    require_auth( from );
+    check( transfers.size() > 0, "must transfer to at least one account" );
+    check( memo.size() <= 256, "memo has more than 256 bytes" );
+
+    auto sym = transfers.front().second.symbol;
+    stats statstable( get_self(), sym.code().raw() );
+    const auto& st = statstable.get( sym.code().raw() );
+    check( sym == st.supply.symbol, "symbol precision mismatch" );
+
+    require_recipient( from );
+
+    asset total( 0, sym );
+    for( const auto& t : transfers ) {
+       check( from != t.first, "cannot transfer to self" );
+       check( is_account( t.first ), "to account does not exist");
+       check( t.second.is_valid(), "invalid quantity" );
+       check( t.second.amount > 0, "must transfer positive quantity" );
+       check( t.second.symbol == sym, "symbol precision mismatch" );
+       total += t.second;
+    }
+
+    sub_balance( from, total );
+
+    for( const auto& t : transfers ) {
+       require_recipient( t.first );
+
+       auto payer = has_auth( t.first ) ? t.first : from;
+       add_balance( t.first, t.second, payer );
+    }
+}
+
 void token::sub_balance( const name& owner, const asset& value ) {
    accounts from_acnts( get_self(), owner.value );
 
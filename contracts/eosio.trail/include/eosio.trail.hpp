@@ -16,6 +16,7 @@
 #include <eosio/singleton.hpp>
 #include <eosio/dispatcher.hpp>
 #include <string>
+#include <map>
 
 using namespace eosio;
 
@@ -32,6 +33,9 @@ public:
     environment_singleton environment;
     env env_struct;
 
+    registries_table registries;
+    std::map<uint64_t, registry> registry_cache; //NOTE: registries changed by this action, written back in ~trail()
+
     #pragma region Constants
 
     uint64_t const VOTE_ISSUE_RATIO = 1; //indicates a 1:1 TLOS/VOTE issuance
@@ -62,6 +66,8 @@ public:
 
     [[eosio::action]] void issuetoken(name publisher, name recipient, asset tokens, bool airgrab);
 
+    [[eosio::action]] void issuemany(name publisher, vector<pair<name, asset>> recipients);
+
     [[eosio::action]] void claimairgrab(name claimant, name publisher, symbol token_symbol);
 
     [[eosio::action]] void burntoken(name balance_owner, asset amount);
@@ -122,7 +128,7 @@ public:
 
     [[eosio::action]] void unregballot(name publisher, uint64_t ballot_id);
 
-    //TODO: archivebal() action to replace ballot publisher's RAM with Trail's RAM. Could require TLOS payment?
+    [[eosio::action]] void archiveballot(name publisher, uint64_t ballot_id);
 
     #pragma endregion Ballot_Registration
 
@@ -176,7 +182,12 @@ public:
 
     asset get_vote_weight(name voter, symbol voting_token);
 
-    bool has_direction(uint16_t direction, vector<uint16_t> direction_list);
+    //NOTE: returned pointers are only valid for reading before the next modify_registry() call
+    const registry* find_registry(symbol_code code);
+
+    template<typename Lambda>
+    void modify_registry(symbol_code code, Lambda&& updater);
+
 
     vector<candidate> set_candidate_statuses(vector<candidate> candidate_list, vector<uint8_t> new_status_list);
 
@@ -194,7 +205,5 @@ public:
 
     void update_to_cb(const name &to, const asset &amount);
 
-    asset get_decay_amount(name voter, symbol token_symbol, uint32_t decay_rate);
-
     #pragma endregion Reactions
 };
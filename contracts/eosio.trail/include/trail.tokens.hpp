@@ -105,6 +105,33 @@ typedef multi_index<name("registries"), registry> registries_table;
 
 #pragma region Helper_Functions
 
+//NOTE: powers of ten indexed by symbol precision (max precision is 18)
+constexpr int64_t precision_units[] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL, 1000000000LL,
+    10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL,
+    1000000000000000LL, 10000000000000000LL, 100000000000000000LL, 1000000000000000000LL
+};
+
+//NOTE: decayable counterbalances are stored as (amount, last_decay) and evaluated lazily. Every whole decay_rate
+//      seconds since last_decay removes one whole token. last_decay advances by the periods applied so partial
+//      periods carry over to the next evaluation.
+counter_balance apply_decay(counter_balance cb, uint32_t time_now, uint32_t decay_rate) {
+    if (time_now <= cb.last_decay) {
+        return cb;
+    }
+
+    uint32_t periods = (time_now - cb.last_decay) / decay_rate;
+    int64_t unit = precision_units[cb.decayable_cb.symbol.precision()];
+
+    if (cb.decayable_cb.amount / unit < periods) { //NOTE: fully decayed, avoids overflowing periods * unit
+        cb.decayable_cb.amount = 0;
+    } else {
+        cb.decayable_cb.amount -= int64_t(periods) * unit;
+    }
+
+    cb.last_decay += periods * decay_rate;
 
+    return cb;
+}
 
 #pragma endregion Helper_Functions
@@ -11,6 +11,10 @@
 #include <eosio/asset.hpp>
 #include <eosio/action.hpp>
 #include <eosio/singleton.hpp>
+#include <eosio/binary_extension.hpp>
+
+#include <algorithm>
+#include <numeric>
 
 using namespace std;
 using namespace eosio;
@@ -23,21 +27,29 @@ using namespace eosio;
 //     FAIL
 // };
 
+//NOTE: table_id of an archived ballot. Its reference_id may belong to a newer proposal or leaderboard.
+const uint8_t ARCHIVED_BALLOT = 255;
+
 #pragma endregion Constants
 
 #pragma region Structs
 
 //NOTE: vote receipts MUST be scoped by voter
+//NOTE: receipts without a version list their directions. BITSET_RECEIPT receipts (leaderboards) leave directions
+//      empty and set bit (direction % 8) of direction_bits[direction / 8] instead. Use has_direction() to
+//      read either encoding.
 struct [[eosio::table, eosio::contract("eosio.trail")]] vote_receipt {
     uint64_t ballot_id;
     vector<uint16_t> directions;
     asset weight;
     uint32_t expiration;
+    binary_extension<uint8_t> version;
+    binary_extension<vector<uint8_t>> direction_bits;
 
     //TODO: make vector of weights? directions[i] => weights[i]
 
     uint64_t primary_key() const { return ballot_id; }
-    EOSLIB_SERIALIZE(vote_receipt, (ballot_id)(directions)(weight)(expiration))
+    EOSLIB_SERIALIZE(vote_receipt, (ballot_id)(directions)(weight)(expiration)(version)(direction_bits))
 };
 
 struct candidate {
@@ -119,6 +131,26 @@ struct [[eosio::table, eosio::contract("eosio.trail")]] leaderboard {
         (begin_time)(end_time)(status))
 };
 
+//NOTE: ballot results MUST be scoped by name("eosio.trail").value
+//NOTE: proposal tallies are [no, yes, abstain]. Leaderboard tallies follow the order of members.
+struct [[eosio::table, eosio::contract("eosio.trail")]] ballot_result {
+    uint64_t ballot_id;
+    uint8_t table_id;
+    name publisher;
+
+    vector<name> members;
+    vector<asset> tallies;
+    uint32_t unique_voters;
+
+    uint32_t end_time;
+    uint8_t status;
+
+    uint64_t primary_key() const { return ballot_id; }
+    EOSLIB_SERIALIZE(ballot_result, (ballot_id)(table_id)(publisher)
+        (members)(tallies)(unique_voters)
+        (end_time)(status))
+};
+
 /**
  * NOTE: totals vector mappings:
  *     totals[0] => total proposals
@@ -172,6 +204,8 @@ typedef multi_index<name("leaderboards"), leaderboard> leaderboards_table;
 
 typedef multi_index<name("votereceipts"), vote_receipt> votereceipts_table;
 
+typedef multi_index<name("results"), ballot_result> results_table;
+
 //typedef multi_index<name("proxreceipts"), proxy_receipt> proxyreceipts_table;
 
 typedef singleton<name("environment"), env> environment_singleton;
@@ -181,6 +215,42 @@ typedef singleton<name("environment"), env> environment_singleton;
 
 #pragma region Helper_Functions
 
+const uint8_t BITSET_RECEIPT = 1;
+
+bool has_direction(const vote_receipt& vr, uint16_t direction) {
+    if (vr.version.value_or(0) == BITSET_RECEIPT) {
+        const auto& bits = vr.direction_bits.value();
+        return direction / 8 < bits.size() && ((bits[direction / 8] >> (direction % 8)) & 1);
+    }
+
+    return std::find(vr.directions.begin(), vr.directions.end(), direction) != vr.directions.end();
+}
+
+//NOTE: converts older receipts to the bitset encoding before setting the new direction
+void add_direction(vote_receipt& vr, uint16_t direction) {
+    vector<uint8_t> bits;
+
+    if (vr.version.value_or(0) == BITSET_RECEIPT) {
+        bits = vr.direction_bits.value();
+    } else {
+        for (uint16_t d : vr.directions) {
+            if (d / 8 >= bits.size()) {
+                bits.resize(d / 8 + 1);
+            }
+            bits[d / 8] |= uint8_t(1 << (d % 8));
+        }
+        vr.directions.clear();
+        vr.version.emplace(BITSET_RECEIPT);
+    }
+
+    if (direction / 8 >= bits.size()) {
+        bits.resize(direction / 8 + 1);
+    }
+    bits[direction / 8] |= uint8_t(1 << (direction % 8));
+
+    vr.direction_bits.emplace(std::move(bits));
+}
+
 bool is_ballot(uint64_t ballot_id) {
     ballots_table ballots(name("eosio.trail"), name("eosio.trail").value);
     auto b = ballots.find(ballot_id);
@@ -192,4 +262,39 @@ bool is_ballot(uint64_t ballot_id) {
     return false;
 }
 
+/**
+ * Returns the candidates that won a seat on a closed leaderboard, ordered by votes descending.
+ * 
+ * NOTE: only the top available_seats + 1 tallies are ranked. If there are more candidates than seats,
+ * every candidate tied with the first candidate left out also loses their seat.
+ */
+vector<candidate> get_leaderboard_winners(const leaderboard& board) {
+    const auto& cands = board.candidates;
+    size_t seats = board.available_seats;
+
+    vector<uint16_t> ranks(cands.size());
+    std::iota(ranks.begin(), ranks.end(), uint16_t(0));
+    auto by_votes = [&cands](uint16_t c1, uint16_t c2) { return cands[c1].votes > cands[c2].votes; };
+
+    vector<candidate> winners;
+    if (cands.size() <= seats) {
+        std::sort(ranks.begin(), ranks.end(), by_votes);
+        winners.reserve(ranks.size());
+        for (auto r : ranks) {
+            winners.emplace_back(cands[r]);
+        }
+        return winners;
+    }
+
+    std::partial_sort(ranks.begin(), ranks.begin() + seats + 1, ranks.end(), by_votes);
+    const asset& first_out = cands[ranks[seats]].votes;
+
+    winners.reserve(seats);
+    for (size_t i = 0; i < seats && cands[ranks[i]].votes > first_out; i++) {
+        winners.emplace_back(cands[ranks[i]]);
+    }
+
+    return winners;
+}
+
 #pragma endregion Helper_Functions
@@ -1,6 +1,6 @@
 #include "../include/eosio.trail.hpp"
 
-trail::trail(name self, name code, datastream<const char*> ds) : contract(self, code, ds), environment(self, self.value) {
+trail::trail(name self, name code, datastream<const char*> ds) : contract(self, code, ds), environment(self, self.value), registries(self, self.value) {
     if (!environment.exists()) {
         vector<uint64_t> new_totals = {0,0,0};
 
@@ -22,6 +22,32 @@ trail::~trail() {
     if (environment.exists()) {
         environment.set(env_struct, env_struct.publisher);
     }
+
+    for (const auto& dirty : registry_cache) { //NOTE: single write-back per changed registry
+        registries.modify(registries.find(dirty.first), same_payer, [&]( auto& a ) {
+            a = dirty.second;
+        });
+    }
+}
+
+const registry* trail::find_registry(symbol_code code) {
+    auto c = registry_cache.find(code.raw());
+    if (c != registry_cache.end()) {
+        return &c->second;
+    }
+
+    auto r = registries.find(code.raw());
+    return r == registries.end() ? nullptr : &*r;
+}
+
+template<typename Lambda>
+void trail::modify_registry(symbol_code code, Lambda&& updater) {
+    auto c = registry_cache.find(code.raw());
+    if (c == registry_cache.end()) {
+        c = registry_cache.emplace(code.raw(), registries.get(code.raw(), "registry doesn't exist")).first;
+    }
+
+    updater(c->second);
 }
 
 #pragma region Token_Registration
@@ -31,9 +57,7 @@ void trail::regtoken(asset max_supply, name publisher, string info_url) {
 
     auto sym = max_supply.symbol;
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(sym.code().raw());
-    check(r == registries.end(), "Token Registry with that symbol already exists in Trail");
+    check(find_registry(sym.code()) == nullptr, "Token Registry with that symbol already exists in Trail");
 
     token_settings default_settings;
 
@@ -53,21 +77,19 @@ void trail::regtoken(asset max_supply, name publisher, string info_url) {
 void trail::initsettings(name publisher, symbol token_symbol, token_settings new_settings) {
     require_auth(publisher);
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(token_symbol.code().raw());
-    check(r != registries.end(), "Token Registry with that symbol doesn't exist");
-    auto reg = *r;
+    auto reg = find_registry(token_symbol.code());
+    check(reg != nullptr, "Token Registry with that symbol doesn't exist");
 
-    check(reg.publisher == publisher, "cannot change settings of another account's registry");
+    check(reg->publisher == publisher, "cannot change settings of another account's registry");
     check(new_settings.counterbal_decay_rate > 0, "cannot have a counterbalance with zero decay");
 
-    if (reg.settings.is_initialized) {
-        check(!reg.settings.lock_after_initialize, "settings have been locked");
+    if (reg->settings.is_initialized) {
+        check(!reg->settings.lock_after_initialize, "settings have been locked");
     } else {
         new_settings.is_initialized = true;
     }
 
-    registries.modify(r, same_payer, [&]( auto& a ) {
+    modify_registry(token_symbol.code(), [&]( auto& a ) {
         a.settings = new_settings;
     });
 
@@ -77,14 +99,12 @@ void trail::initsettings(name publisher, symbol token_symbol, token_settings new
 void trail::unregtoken(symbol token_symbol, name publisher) {
     require_auth(publisher);
     
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(token_symbol.code().raw());
-    check(r != registries.end(), "No Token Registry found matching given symbol");
-    auto reg = *r;
+    auto reg = find_registry(token_symbol.code());
+    check(reg != nullptr, "No Token Registry found matching given symbol");
 
-    check(reg.settings.is_destructible == true, "Token Registry has been set as indestructible");
+    check(reg->settings.is_destructible == true, "Token Registry has been set as indestructible");
 
-    registries.erase(r);
+    registries.erase(registries.find(token_symbol.code().raw()));
 
     print("\nToken Unregistration: SUCCESS");
 }
@@ -98,16 +118,14 @@ void trail::issuetoken(name publisher, name recipient, asset tokens, bool airgra
     require_auth(publisher);
     check(tokens > asset(0, tokens.symbol), "must issue more than 0 tokens");
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(tokens.symbol.code().raw());
-    check(r != registries.end(), "registry doesn't exist for that token");
-    auto reg = *r;
-    check(reg.publisher == publisher, "only publisher can issue tokens");
+    auto reg = find_registry(tokens.symbol.code());
+    check(reg != nullptr, "registry doesn't exist for that token");
+    check(reg->publisher == publisher, "only publisher can issue tokens");
 
-    asset new_supply = (reg.supply + tokens);
-    check(new_supply <= reg.max_supply, "Issuing tokens would breach max supply");
+    asset new_supply = (reg->supply + tokens);
+    check(new_supply <= reg->max_supply, "Issuing tokens would breach max supply");
 
-    registries.modify(r, same_payer, [&]( auto& a ) { //NOTE: update supply
+    modify_registry(tokens.symbol.code(), [&]( auto& a ) { //NOTE: update supply
         a.supply = new_supply;
     });
 
@@ -151,16 +169,59 @@ void trail::issuetoken(name publisher, name recipient, asset tokens, bool airgra
     print("\nRecipient: ", recipient);
 }
 
+//NOTE: airdrops to every recipient, supply is updated once for the whole batch
+void trail::issuemany(name publisher, vector<pair<name, asset>> recipients) {
+    require_auth(publisher);
+    check(!recipients.empty(), "must issue to at least one recipient");
+
+    symbol token_symbol = recipients.front().second.symbol;
+    asset total = asset(0, token_symbol);
+    for (const auto& rec : recipients) {
+        check(rec.second.symbol == token_symbol, "all issued tokens must have the same symbol");
+        check(rec.second > asset(0, token_symbol), "must issue more than 0 tokens");
+        total += rec.second;
+    }
+
+    auto reg = find_registry(token_symbol.code());
+    check(reg != nullptr, "registry doesn't exist for that token");
+    check(reg->publisher == publisher, "only publisher can issue tokens");
+
+    asset new_supply = (reg->supply + total);
+    check(new_supply <= reg->max_supply, "Issuing tokens would breach max supply");
+
+    modify_registry(token_symbol.code(), [&]( auto& a ) { //NOTE: update supply
+        a.supply = new_supply;
+    });
+
+    balances_table balances(_self, token_symbol.code().raw());
+    for (const auto& rec : recipients) { //NOTE: publisher pays RAM cost if recipient has no balance entry
+        auto b = balances.find(rec.first.value);
+
+        if (b == balances.end()) { //NOTE: new balance
+            balances.emplace(publisher, [&]( auto& a ){
+                a.owner = rec.first;
+                a.tokens = rec.second;
+            });
+        } else { //NOTE: add to existing balance
+            balances.modify(b, same_payer, [&]( auto& a ) {
+                a.tokens += rec.second;
+            });
+        }
+    }
+
+    print("\nToken Airdrop: SUCCESS");
+    print("\nAmount: ", total);
+    print("\nRecipients: ", recipients.size());
+}
+
 //TODO: remove pulisher as param? is findable through token symbol (implemented, just need to remove from signature)
 void trail::claimairgrab(name claimant, name publisher, symbol token_symbol) {
     require_auth(claimant);
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(token_symbol.code().raw());
-    check(r != registries.end(), "Token Registry with that symbol doesn't exist in Trail");
-    auto reg = *r;
+    auto reg = find_registry(token_symbol.code());
+    check(reg != nullptr, "Token Registry with that symbol doesn't exist in Trail");
 
-    airgrabs_table airgrabs(_self, reg.publisher.value);
+    airgrabs_table airgrabs(_self, reg->publisher.value);
     auto g = airgrabs.find(claimant.value);
     check(g != airgrabs.end(), "no airgrab to claim");
     auto grab = *g;
@@ -190,25 +251,23 @@ void trail::burntoken(name balance_owner, asset amount) {
     require_auth(balance_owner);
     check(amount > asset(0, amount.symbol), "must claim more than 0 tokens");
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(amount.symbol.code().raw());
-    check(r != registries.end(), "registry doesn't exist for given token");
-    auto reg = *r;
+    auto reg = find_registry(amount.symbol.code());
+    check(reg != nullptr, "registry doesn't exist for given token");
 
     //TODO: make is_burnable_by_publisher/is_burnable_by_holder?
-    check(reg.settings.is_burnable == true, "token registry doesn't allow burning");
+    check(reg->settings.is_burnable == true, "token registry doesn't allow burning");
 
     balances_table balances(_self, amount.symbol.code().raw());
     auto b = balances.find(balance_owner.value);
     check(b != balances.end(), "balance owner has no balance to burn");
     auto bal = *b;
 
-    asset new_supply = (reg.supply - amount);
+    asset new_supply = (reg->supply - amount);
     asset new_balance = bal.tokens - amount;
 
     check(new_balance >= asset(0, bal.tokens.symbol), "cannot burn more tokens than are owned");
 
-    registries.modify(r, same_payer, [&]( auto& a ) {
+    modify_registry(amount.symbol.code(), [&]( auto& a ) {
         a.supply = new_supply;
     });
 
@@ -225,13 +284,11 @@ void trail::seizetoken(name publisher, name owner, asset tokens) {
     check(publisher != owner, "cannot seize your own tokens");
     check(tokens > asset(0, tokens.symbol), "must seize greater than 0 tokens");
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(tokens.symbol.code().raw());
-    check(r != registries.end(), "registry doesn't exist for given token");
-    auto reg = *r;
+    auto reg = find_registry(tokens.symbol.code());
+    check(reg != nullptr, "registry doesn't exist for given token");
 
-    check(reg.publisher == publisher, "only publisher can seize tokens");
-    check(reg.settings.is_seizable == true, "token registry doesn't allow seizing");
+    check(reg->publisher == publisher, "only publisher can seize tokens");
+    check(reg->settings.is_seizable == true, "token registry doesn't allow seizing");
 
     balances_table ownerbals(_self, tokens.symbol.code().raw());
     auto ob = ownerbals.find(owner.value);
@@ -259,13 +316,11 @@ void trail::seizeairgrab(name publisher, name recipient, asset amount) {
     require_auth(publisher);
     check(amount > asset(0, amount.symbol), "must seize greater than 0 tokens");
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(amount.symbol.code().raw());
-    check(r != registries.end(), "registry doesn't exist for given token");
-    auto reg = *r;
+    auto reg = find_registry(amount.symbol.code());
+    check(reg != nullptr, "registry doesn't exist for given token");
 
-    check(reg.publisher == publisher, "only publisher can seize airgrabs");
-    check(reg.settings.is_seizable == true, "token registry doesn't allow seizing");
+    check(reg->publisher == publisher, "only publisher can seize airgrabs");
+    check(reg->settings.is_seizable == true, "token registry doesn't allow seizing");
 
     airgrabs_table airgrabs(_self, publisher.value);
     auto g = airgrabs.find(recipient.value);
@@ -299,35 +354,31 @@ void trail::seizebygroup(name publisher, vector<name> group, asset tokens) {
     //check(publisher != owner, "cannot seize your own tokens");
     check(tokens > asset(0, tokens.symbol), "must seize greater than 0 tokens");
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(tokens.symbol.code().raw());
-    check(r != registries.end(), "registry doesn't exist for given token");
-    auto reg = *r;
+    auto reg = find_registry(tokens.symbol.code());
+    check(reg != nullptr, "registry doesn't exist for given token");
 
-    check(reg.publisher == publisher, "only publisher can seize tokens");
-    check(reg.settings.is_seizable == true, "token registry doesn't allow seizing");
+    check(reg->publisher == publisher, "only publisher can seize tokens");
+    check(reg->settings.is_seizable == true, "token registry doesn't allow seizing");
 
-    for (name n : group) {
+    balances_table balances(_self, tokens.symbol.code().raw());
+    auto pb = balances.find(publisher.value);
+    check(pb != balances.end(), "publisher has no balance to hold seized tokens");
 
-        balances_table ownerbals(_self, tokens.symbol.code().raw());
-        auto ob = ownerbals.find(n.value);
-        check(ob != ownerbals.end(), "user has no balance to seize");
-        auto obal = *ob;
-        check(obal.tokens - tokens >= asset(0, obal.tokens.symbol), "cannot seize more tokens than user owns");
+    asset seized = asset(0, tokens.symbol);
+    for (name n : group) {
+        auto ob = balances.find(n.value);
+        check(ob != balances.end(), "user has no balance to seize");
+        check(ob->tokens - tokens >= asset(0, ob->tokens.symbol), "cannot seize more tokens than user owns");
 
-        ownerbals.modify(ob, same_payer, [&]( auto& a ) { //NOTE: subtract amount from balance
+        balances.modify(ob, same_payer, [&]( auto& a ) { //NOTE: subtract amount from balance
             a.tokens -= tokens;
         });
+        seized += tokens;
+    }
 
-        balances_table publisherbal(_self, tokens.symbol.code().raw());
-        auto pb = publisherbal.find(publisher.value);
-        check(pb != publisherbal.end(), "publisher has no balance to hold seized tokens");
-        auto pbal = *pb;
-
-        publisherbal.modify(pb, same_payer, [&]( auto& a ) { //NOTE: add seized tokens to publisher balance
-            a.tokens += tokens;
-        });
-    } 
+    balances.modify(pb, same_payer, [&]( auto& a ) { //NOTE: add all seized tokens to publisher balance at once
+        a.tokens += seized;
+    });
 
     print("\nToken Seizure: SUCCESS");
 }
@@ -336,15 +387,13 @@ void trail::raisemax(name publisher, asset amount) {
     require_auth(publisher);
     check(amount > asset(0, amount.symbol), "amount must be greater than 0");
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(amount.symbol.code().raw());
-    check(r != registries.end(), "registry doesn't exist for given token");
-    auto reg = *r;
+    auto reg = find_registry(amount.symbol.code());
+    check(reg != nullptr, "registry doesn't exist for given token");
 
-    check(reg.publisher == publisher, "cannot raise another registry's max supply");
-    check(reg.settings.is_max_mutable == true, "token registry doesn't allow raising max supply");
+    check(reg->publisher == publisher, "cannot raise another registry's max supply");
+    check(reg->settings.is_max_mutable == true, "token registry doesn't allow raising max supply");
 
-    registries.modify(r, same_payer, [&]( auto& a ) {
+    modify_registry(amount.symbol.code(), [&]( auto& a ) {
         a.max_supply += amount;
     });
 
@@ -355,17 +404,15 @@ void trail::lowermax(name publisher, asset amount) {
     require_auth(publisher);
     check(amount > asset(0, amount.symbol), "amount must be greater than 0");
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(amount.symbol.code().raw());
-    check(r != registries.end(), "registry doesn't exist for that token");
-    auto reg = *r;
+    auto reg = find_registry(amount.symbol.code());
+    check(reg != nullptr, "registry doesn't exist for that token");
 
-    check(reg.publisher == publisher, "cannot lower another account's max supply");
-    check(reg.settings.is_max_mutable == true, "token settings don't allow lowering max supply");
-    check(reg.supply <= reg.max_supply - amount, "cannot lower max supply below circulating supply");
-    check(reg.max_supply - amount >= asset(0, amount.symbol), "cannot lower max supply below 0");
+    check(reg->publisher == publisher, "cannot lower another account's max supply");
+    check(reg->settings.is_max_mutable == true, "token settings don't allow lowering max supply");
+    check(reg->supply <= reg->max_supply - amount, "cannot lower max supply below circulating supply");
+    check(reg->max_supply - amount >= asset(0, amount.symbol), "cannot lower max supply below 0");
 
-    registries.modify(r, same_payer, [&]( auto& a ) {
+    modify_registry(amount.symbol.code(), [&]( auto& a ) {
         a.max_supply -= amount;
     });
 
@@ -377,12 +424,10 @@ void trail::transfer(name sender, name recipient, asset amount) {
     check(sender != recipient, "cannot send tokens to yourself");
     check(amount > asset(0, amount.symbol), "must transfer grater than 0 tokens");
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(amount.symbol.code().raw());
-    check(r != registries.end(), "token registry doesn't exist");
-    auto reg = *r;
+    auto reg = find_registry(amount.symbol.code());
+    check(reg != nullptr, "token registry doesn't exist");
 
-    check(reg.settings.is_transferable == true, "token registry disallows transfers");
+    check(reg->settings.is_transferable == true, "token registry disallows transfers");
 
     balances_table senderbal(_self, amount.symbol.code().raw());
     auto sb = senderbal.find(sender.value);
@@ -418,19 +463,17 @@ void trail::transfer(name sender, name recipient, asset amount) {
             a.last_decay = current_time_point().sec_since_epoch();
         });
     } else {
-        auto scbal = *scb;
-        asset s_decay_amount = get_decay_amount(sender, amount.symbol, reg.settings.counterbal_decay_rate);
-        asset new_s_cbal = (scbal.decayable_cb - s_decay_amount) - amount;
+        auto scbal = apply_decay(*scb, env_struct.time_now, reg->settings.counterbal_decay_rate);
+        asset new_s_cbal = scbal.decayable_cb - amount;
 
         if (new_s_cbal < asset(0, scbal.decayable_cb.symbol)) { //NOTE: if scbal < 0, set to 0
-            sendercb.modify(scb, same_payer, [&]( auto& a ) {
-                a.decayable_cb = asset(0, scbal.decayable_cb.symbol);
-            });
-        } else {
-            sendercb.modify(scb, same_payer, [&]( auto& a ) {
-                a.decayable_cb = new_s_cbal;
-            });
+            new_s_cbal = asset(0, scbal.decayable_cb.symbol);
         }
+
+        sendercb.modify(scb, same_payer, [&]( auto& a ) {
+            a.decayable_cb = new_s_cbal;
+            a.last_decay = scbal.last_decay;
+        });
     }
 
     counterbalances_table reccb(_self, amount.symbol.code().raw());
@@ -444,18 +487,11 @@ void trail::transfer(name sender, name recipient, asset amount) {
             a.last_decay = current_time_point().sec_since_epoch();
         });
     } else {
-        auto rcbal = *rcb;
-        asset r_decay_amount = get_decay_amount(recipient, amount.symbol, reg.settings.counterbal_decay_rate);
-        asset new_r_cbal = (rcbal.decayable_cb - r_decay_amount);
-
-        if (new_r_cbal <= asset(0, rcbal.decayable_cb.symbol)) { //NOTE: only triggers if decayed below 0
-            new_r_cbal = asset(0, rcbal.decayable_cb.symbol);
-        }
-
-        new_r_cbal += amount;
+        auto rcbal = apply_decay(*rcb, env_struct.time_now, reg->settings.counterbal_decay_rate);
         
         reccb.modify(rcb, same_payer, [&]( auto& a ) {
-            a.decayable_cb = new_r_cbal;
+            a.decayable_cb = rcbal.decayable_cb + amount;
+            a.last_decay = rcbal.last_decay;
         });
     }
 
@@ -473,9 +509,7 @@ void trail::regvoter(name voter, symbol token_symbol) {
 
     //symbol core_symbol = symbol("VOTE", 4);
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(token_symbol.code().raw());
-    check(r != registries.end(), "registry doesn't exist for given token");
+    check(find_registry(token_symbol.code()) != nullptr, "registry doesn't exist for given token");
 
     balances_table balances(_self, token_symbol.code().raw());
     auto b = balances.find(voter.value);
@@ -486,7 +520,7 @@ void trail::regvoter(name voter, symbol token_symbol) {
         a.tokens = asset(0, token_symbol);
     });
 
-    registries.modify(r, same_payer, [&]( auto& a ) {
+    modify_registry(token_symbol.code(), [&]( auto& a ) {
         a.total_voters += uint32_t(1);
     });
 
@@ -504,14 +538,12 @@ void trail::unregvoter(name voter, symbol token_symbol) {
     check(b != balances.end(), "voter doesn't exist to unregister");
     auto bal = *b;
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(token_symbol.code().raw());
-    check(r != registries.end(), "registry doesn't exist");
-    auto reg = *r;
+    auto reg = find_registry(token_symbol.code());
+    check(reg != nullptr, "registry doesn't exist");
 
-    check(reg.settings.is_burnable == true, "token registry disallows burning of funds, transfer whole balance before attempting to unregister.");
+    check(reg->settings.is_burnable == true, "token registry disallows burning of funds, transfer whole balance before attempting to unregister.");
 
-    registries.modify(r, same_payer, [&]( auto& a ) {
+    modify_registry(token_symbol.code(), [&]( auto& a ) {
         a.supply -= bal.tokens;
         a.total_voters -= uint32_t(1);
     });
@@ -546,34 +578,26 @@ void trail::mirrorcast(name voter, symbol token_symbol) {
     auto bal = *b;
 
     //subtract old balance from supply
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(vote_sym.code().raw());
-    check(r != registries.end(), "Token Registry with that symbol doesn't exist in Trail");
-    auto reg = *r;
-    reg.supply -= bal.tokens;
+    auto reg = find_registry(vote_sym.code());
+    check(reg != nullptr, "Token Registry with that symbol doesn't exist in Trail");
+    asset new_supply = reg->supply - bal.tokens;
 
     counterbalances_table counterbals(_self, new_votes.symbol.code().raw());
     auto cb = counterbals.find(voter.value);
     //asset cb_weight = asset(0, max_votes.symbol);
-    counter_balance counter_bal;
-
-    asset decay_amount = get_decay_amount(voter, new_votes.symbol, DECAY_RATE);
     
     if (cb != counterbals.end()) { //NOTE: if no cb found, give cb of 0
-        auto counter_bal = *cb;
+        auto counter_bal = apply_decay(*cb, env_struct.time_now, DECAY_RATE);
         //check(current_time_point().sec_since_epoch() - counter_bal.last_decay >= MIN_LOCK_PERIOD, "cannot get more votes until min lock period is over");
-        asset new_cb = (counter_bal.decayable_cb - decay_amount); //subtracting total cb
+        asset new_cb = counter_bal.decayable_cb; //subtracting total cb
 
 		//TODO: should mirrorcasting add new_votes to counterbalance? same logically as adding when calling issuetokens
 
-        if (new_cb < asset(0, symbol("VOTE", 4))) {
-            new_cb = asset(0, symbol("VOTE", 4));
-        }
-
         new_votes -= new_cb;
 
         counterbals.modify(cb, same_payer, [&]( auto& a ) {
             a.decayable_cb = new_cb;
+            a.last_decay = counter_bal.last_decay;
         });
     }
 
@@ -586,9 +610,9 @@ void trail::mirrorcast(name voter, symbol token_symbol) {
     });
 
     //update supply
-    reg.supply += new_votes;
-    registries.modify(r, same_payer, [&]( auto& a ) {
-        a.supply = reg.supply;
+    new_supply += new_votes;
+    modify_registry(vote_sym.code(), [&]( auto& a ) {
+        a.supply = new_supply;
     });
 
     //TODO: trail vote update
@@ -610,6 +634,7 @@ void trail::castvote(name voter, uint64_t ballot_id, uint16_t direction) {
     auto b = ballots.find(ballot_id);
     check(b != ballots.end(), "ballot with given ballot_id doesn't exist");
     auto bal = *b;
+    check(bal.table_id != ARCHIVED_BALLOT, "ballot has been archived");
 
     //TODO: factor out get_weight?
     // balances_table balances(_self, _self.value);
@@ -676,9 +701,7 @@ void trail::regballot(name publisher, uint8_t ballot_type, symbol voting_symbol,
     check(ballot_type >= 0 && ballot_type <= 2, "invalid ballot type"); //NOTE: update valid range as new ballot types are developed
     check(begin_time < end_time, "begin time must be less than end time");
 
-    registries_table registries(_self, _self.value);
-    auto r = registries.find(voting_symbol.code().raw());
-    check(r != registries.end(), "Token registry with that symbol doesn't exist in Trail");
+    check(find_registry(voting_symbol.code()) != nullptr, "Token registry with that symbol doesn't exist in Trail");
 
     uint64_t new_ref_id;
 
@@ -720,6 +743,7 @@ void trail::unregballot(name publisher, uint64_t ballot_id) {
     auto b = ballots.find(ballot_id);
     check(b != ballots.end(), "Ballot Doesn't Exist");
     auto bal = *b;
+    check(bal.table_id != ARCHIVED_BALLOT, "ballot has been archived");
 
     bool del_success = false;
 
@@ -746,6 +770,76 @@ void trail::unregballot(name publisher, uint64_t ballot_id) {
     print("\nBallot ID Deleted: ", bal.ballot_id);
 }
 
+//NOTE: the ballot row is kept so ballot ids are never reused, but marked archived because
+//      the reference id it held can be handed out again to a new proposal or leaderboard
+void trail::archiveballot(name publisher, uint64_t ballot_id) {
+    require_auth(publisher);
+
+    ballots_table ballots(_self, _self.value);
+    auto b = ballots.find(ballot_id);
+    check(b != ballots.end(), "Ballot Doesn't Exist");
+    auto bal = *b;
+    check(bal.table_id != ARCHIVED_BALLOT, "ballot has been archived");
+
+    ballot_result res;
+    res.ballot_id = ballot_id;
+    res.table_id = bal.table_id;
+    res.publisher = publisher;
+
+    switch (bal.table_id) {
+        case 0 : {
+            proposals_table proposals(_self, _self.value);
+            auto p = proposals.find(bal.reference_id);
+            check(p != proposals.end(), "proposal doesn't exist");
+            check(p->publisher == publisher, "cannot archive another account's proposal");
+            check(env_struct.time_now > p->end_time, "cannot archive proposal while voting is still open");
+            check(p->status != 0, "cannot archive proposal before it is closed");
+
+            res.tallies = { p->no_count, p->yes_count, p->abstain_count };
+            res.unique_voters = p->unique_voters;
+            res.end_time = p->end_time;
+            res.status = p->status;
+
+            proposals.erase(p);
+            break;
+        }
+        case 2 : {
+            leaderboards_table leaderboards(_self, _self.value);
+            auto l = leaderboards.find(bal.reference_id);
+            check(l != leaderboards.end(), "leaderboard doesn't exist");
+            check(l->publisher == publisher, "cannot archive another account's leaderboard");
+            check(env_struct.time_now > l->end_time, "cannot archive leaderboard while voting is still open");
+            check(l->status != 0, "cannot archive leaderboard before it is closed");
+
+            res.members.reserve(l->candidates.size());
+            res.tallies.reserve(l->candidates.size());
+            for (const auto& c : l->candidates) {
+                res.members.emplace_back(c.member);
+                res.tallies.emplace_back(c.votes);
+            }
+            res.unique_voters = l->unique_voters;
+            res.end_time = l->end_time;
+            res.status = l->status;
+
+            leaderboards.erase(l);
+            break;
+        }
+        default : 
+            check(false, "ballot type doesn't support archiving");
+    }
+
+    results_table results(_self, _self.value);
+    results.emplace(publisher, [&]( auto& a ) {
+        a = res;
+    });
+
+    ballots.modify(b, same_payer, [&]( auto& a ) {
+        a.table_id = ARCHIVED_BALLOT;
+    });
+
+    print("\nBallot ID Archived: ", bal.ballot_id);
+}
+
 #pragma endregion Ballot_Registration
 
 
@@ -911,6 +1005,7 @@ void trail::closeballot(name publisher, uint64_t ballot_id, uint8_t pass) {
     auto b = ballots.find(ballot_id);
     check(b != ballots.end(), "ballot with given ballot_id doesn't exist");
     auto bal = *b;
+    check(bal.table_id != ARCHIVED_BALLOT, "ballot has been archived");
 
     bool close_success = false;
 
@@ -938,6 +1033,7 @@ void trail::nextcycle(name publisher, uint64_t ballot_id, uint32_t new_begin_tim
     auto b = ballots.find(ballot_id);
     check(b != ballots.end(), "Ballot Doesn't Exist");
     auto bal = *b;
+    check(bal.table_id != ARCHIVED_BALLOT, "ballot has been archived");
 
     //TODO: support cycles for other ballot types?
     //NOTE: currently only supports proposals
@@ -1020,10 +1116,8 @@ bool trail::vote_for_proposal(name voter, uint64_t ballot_id, uint64_t prop_id,
     check(p != proposals.end(), "proposal doesn't exist");
     auto prop = *p;
 
-	registries_table registries(_self, _self.value);
-    auto r = registries.find(prop.no_count.symbol.code().raw());
-    check(r != registries.end(), "Token Registry with that symbol doesn't exist");
-    auto reg = *r;
+    auto reg = find_registry(prop.no_count.symbol.code());
+    check(reg != nullptr, "Token Registry with that symbol doesn't exist");
 
     check(env_struct.time_now >= prop.begin_time && env_struct.time_now <= prop.end_time, "ballot voting window not open");
 
@@ -1053,7 +1147,7 @@ bool trail::vote_for_proposal(name voter, uint64_t ballot_id, uint64_t prop_id,
 
         if (vr.expiration == prop.end_time) { //NOTE: vote is for same cycle
 
-			check(reg.settings.is_recastable, "token registry disallows vote recasting");
+			check(reg->settings.is_recastable, "token registry disallows vote recasting");
 
             if (vr.directions[0] == direction) {
                 vote_weight -= vr.weight;
@@ -1224,9 +1318,8 @@ bool trail::vote_for_leaderboard(name voter, uint64_t ballot_id, uint64_t board_
     votereceipts_table votereceipts(_self, voter.value);
     auto vr_itr = votereceipts.find(ballot_id);
 
-	registries_table registries(_self, _self.value);
-	auto r = registries.find(board.voting_symbol.code().raw());
-	check(r != registries.end(), "token registry does not exist");
+	auto reg = find_registry(board.voting_symbol.code());
+	check(reg != nullptr, "token registry does not exist");
     
     uint32_t new_voter = 1;
     asset vote_weight = get_vote_weight(voter, board.voting_symbol);
@@ -1235,34 +1328,30 @@ bool trail::vote_for_leaderboard(name voter, uint64_t ballot_id, uint64_t board_
 
     if (vr_itr == votereceipts.end()) { //NOTE: voter hasn't voted on ballot before
 
-        vector<uint16_t> new_directions;
-        new_directions.emplace_back(direction);
-
         votereceipts.emplace(voter, [&]( auto& a ){
             a.ballot_id = ballot_id;
-            a.directions = new_directions;
             a.weight = vote_weight;
             a.expiration = board.end_time;
+            add_direction(a, direction);
         });
 
         print("\nVote Cast: SUCCESS");
         
     } else { //NOTE: vote for ballot_id already exists
         auto vr = *vr_itr;
-		auto reg = *r;
+        bool voted_for = has_direction(vr, direction);
 
-        if (vr.expiration == board.end_time && !has_direction(direction, vr.directions)) { //NOTE: hasn't voted for candidate before
+        if (vr.expiration == board.end_time && !voted_for) { //NOTE: hasn't voted for candidate before
             new_voter = 0;
-            vr.directions.emplace_back(direction);
 
             votereceipts.modify(vr_itr, same_payer, [&]( auto& a ) {
-                a.directions = vr.directions;
+                add_direction(a, direction);
             });
 
             print("\nVote Recast: SUCCESS");
 
-        } else if (vr.expiration == board.end_time && has_direction(direction, vr.directions)) { //NOTE: vote already exists for candidate (recasting)
-			check(reg.settings.is_recastable, "token registry disallows vote recasting");
+        } else if (vr.expiration == board.end_time && voted_for) { //NOTE: vote already exists for candidate (recasting)
+			check(reg->settings.is_recastable, "token registry disallows vote recasting");
             check(true == false, "Feature currently disabled"); //NOTE: temp fix
             new_voter = 0;
 		}
@@ -1311,17 +1400,6 @@ asset trail::get_vote_weight(name voter, symbol voting_symbol) {
     }
 }
 
-bool trail::has_direction(uint16_t direction, vector<uint16_t> direction_list) {
-
-    for (uint16_t item : direction_list) {
-        if (item == direction) {
-            return true;
-        }
-    }
-
-    return false;
-}
-
 vector<candidate> trail::set_candidate_statuses(vector<candidate> candidate_list, vector<uint8_t> new_status_list) {
     check(candidate_list.size() == new_status_list.size(), "status list does not correctly map to candidate list");
 
@@ -1355,7 +1433,7 @@ void trail::update_from_cb(const name &from, const asset &amount) {
             a.last_decay = new_now;
         });
     } else {
-        auto from_cb = *cb_itr;
+        auto from_cb = apply_decay(*cb_itr, env_struct.time_now, DECAY_RATE);
         asset new_cb = from_cb.decayable_cb - amount;
 
         if (new_cb < asset(0, symbol("VOTE", 4))) {
@@ -1364,6 +1442,7 @@ void trail::update_from_cb(const name &from, const asset &amount) {
 
         fromcbs.modify(cb_itr, same_payer, [&]( auto& a ) {
             a.decayable_cb = new_cb;
+            a.last_decay = from_cb.last_decay;
         });
     }
 }
@@ -1381,35 +1460,14 @@ void trail::update_to_cb(const name &to, const asset &amount) {
             a.last_decay = env_struct.time_now;
         });
     } else {
-        auto to_cb = *cb_itr;
+        auto to_cb = apply_decay(*cb_itr, env_struct.time_now, DECAY_RATE);
         asset new_cb = to_cb.decayable_cb + amount;
 
         tocbs.modify(cb_itr, same_payer, [&]( auto& a ) {
             a.decayable_cb = new_cb;
+            a.last_decay = to_cb.last_decay;
         });
     }
 }
 
-asset trail::get_decay_amount(name voter, symbol token_symbol, uint32_t decay_rate) {
-    counterbalances_table counterbals(_self, token_symbol.code().raw());
-    auto cb_itr = counterbals.find(voter.value);
-
-    uint32_t time_delta;
-
-    int prec = token_symbol.precision();
-    int val = 1;
-
-    for (int i = prec; i > 0; i--) {
-        val *= 10;
-    }
-
-    if (cb_itr != counterbals.end()) {
-        auto cb = *cb_itr;
-        time_delta = env_struct.time_now - cb.last_decay;
-        return asset(int64_t(time_delta / decay_rate) * val, token_symbol);
-    }
-
-    return asset(0, token_symbol);
-}
-
 #pragma endregion Reactionsx
@@ -14,6 +14,7 @@
 #include <eosio/action.hpp>
 #include <eosio/singleton.hpp>
 #include <eosio/transaction.hpp>
+#include <eosio/binary_extension.hpp>
 
 using namespace std;
 using namespace eosio;
@@ -131,10 +132,12 @@ public:
 		uint32_t election_frequency = 14515200;
 		uint32_t last_board_election_time;
 		bool is_active_election = false;
+		binary_extension<vector<name>> board_members; //NOTE: sorted mirror of the boardmembers table
 
         uint64_t primary_key() const { return publisher.value; }
         EOSLIB_SERIALIZE(config, (publisher)(max_board_seats)(open_seats)(open_election_id)(holder_quorum_divisor)
-			(board_quorum_divisor)(issue_duration)(start_delay)(leaderboard_duration)(election_frequency)(last_board_election_time)(is_active_election))
+			(board_quorum_divisor)(issue_duration)(start_delay)(leaderboard_duration)(election_frequency)(last_board_election_time)(is_active_election)
+			(board_members))
     };
 
 	struct [[eosio::table]] issue {
@@ -237,6 +240,8 @@ public:
 
 	uint8_t get_occupied_seats();
 
+	vector<name>& get_board_list();
+
 	vector<permission_level_weight> perms_from_members();
 
     #pragma endregion Helper_Functions
@@ -27,6 +27,7 @@ tfvt::config tfvt::get_default_config() {
 		uint32_t(0),		//last_board_election_time
 		false				//is_active_election
 	};
+	c.board_members.emplace();
 	configs.set(c, get_self());
 	return c;
 }
@@ -114,6 +115,7 @@ void tfvt::setconfig(name member, config new_config) {
 	new_config.open_election_id = _config.open_election_id;
 	new_config.last_board_election_time = _config.last_board_election_time;
 	new_config.is_active_election = _config.is_active_election;
+	new_config.board_members.emplace(get_board_list());
 
 	_config = new_config;
 	configs.set(_config, get_self());
@@ -194,15 +196,13 @@ void tfvt::closeissue(name holder, name proposer) {
 	}
 
 	if(state == PASS) {
-		members_table members(get_self(), get_self().value);
+		auto& board = get_board_list();
 		std::vector<permission_level> requested;
-		auto itr = members.begin();
+		requested.reserve(board.size());
 
-		while (itr != members.end()) {
-			// print("adding permission_level: ", name{itr->member});
-			requested.emplace_back(permission_level(itr->member, "active"_n));
-			itr++;
-		}	
+		for(const auto& member : board) {
+			requested.emplace_back(permission_level(member, "active"_n));
+		}
 		
 		action(permission_level{get_self(), name("active")}, name("eosio.msig"), name("propose"), make_tuple(
 			get_self(),
@@ -331,24 +331,7 @@ void tfvt::endelection(name holder) {
     
     leaderboards_table leaderboards(name("eosio.trail"), name("eosio.trail").value);
     auto board = leaderboards.get(bal.reference_id);
-    auto board_candidates = board.candidates;
-
-    sort(board_candidates.begin(), board_candidates.end(), [](const auto &c1, const auto &c2) { return c1.votes > c2.votes; });
-	
-	if(board_candidates.size() > board.available_seats) {
-		auto first_cand_out = board_candidates[board.available_seats];
-		board_candidates.resize(board.available_seats);
-		
-		// count candidates that are tied with first_cand_out
-		uint8_t tied_cands = 0;
-		for(int i = board_candidates.size() - 1; i >= 0; i--) {
-			if(board_candidates[i].votes == first_cand_out.votes) 
-			tied_cands++;
-		}
-
-		// remove all tied candidates
-		if(tied_cands > 0) board_candidates.resize(board_candidates.size() - tied_cands);
-	}
+    auto board_candidates = get_leaderboard_winners(board);
 
 	if(board_candidates.size() > 0 && is_term_expired()) {
 		remove_and_seize_all();
@@ -364,10 +347,8 @@ void tfvt::endelection(name holder) {
 
 	if(currently_elected.size() > 0)
 		set_permissions(currently_elected);
-	
-	members_table members(_self, _self.value);
 
-	_config.open_seats = _config.max_board_seats - uint8_t(std::distance(members.begin(), members.end()));
+	_config.open_seats = _config.max_board_seats - get_occupied_seats();
 
 	action(permission_level{get_self(), name("active")}, name("eosio.trail"), name("closeballot"), make_tuple(
 		get_self(),
@@ -416,6 +397,10 @@ void tfvt::add_to_tfboard(name nominee) {
     mems.emplace(get_self(), [&](auto& m) { //NOTE: emplace in boardmembers table
         m.member = nominee;
     });
+
+	auto& board = get_board_list();
+	board.insert(std::lower_bound(board.begin(), board.end(), nominee), nominee);
+
 	print("\nsending issuetokens inline to ", nominee);
 	asset board_token = asset(1, symbol("TFBOARD", 0));
 	action(permission_level{get_self(), "active"_n }, "eosio.trail"_n, "issuetoken"_n,
@@ -434,6 +419,10 @@ void tfvt::rmv_from_tfboard(name member) {
     check(m != mems.end(), "member is not on the board");
 
     mems.erase(m);
+
+	auto& board = get_board_list();
+	auto b = std::lower_bound(board.begin(), board.end(), member);
+	if(b != board.end() && *b == member) board.erase(b);
 }
 
 void tfvt::addseats(name member, uint8_t num_seats) {
@@ -490,6 +479,7 @@ void tfvt::remove_and_seize_all() {
 		to_seize.emplace_back(itr->member);
 		itr = members.erase(itr);
 	}
+	get_board_list().clear();
 	
 	if(to_seize.size() > 0){
 		action(permission_level{get_self(), "active"_n }, "eosio.trail"_n, "seizebygroup"_n,
@@ -511,11 +501,10 @@ void tfvt::remove_and_seize_all() {
 }
 
 void tfvt::remove_and_seize(name member) {
-	members_table members(get_self(), get_self().value);
 	asset amount_to_seize = asset(1, symbol("TFBOARD", 0));
-	auto m = members.get(member.value, "board member not found");
+	check(is_board_member(member), "board member not found");
 
-	members.erase(m);
+	rmv_from_tfboard(member);
 
 	action(permission_level{get_self(), "active"_n }, "eosio.trail"_n, "seizetoken"_n,
 		std::make_tuple(
@@ -572,17 +561,34 @@ void tfvt::set_permissions(vector<permission_level_weight> perms) {
 	).send();
 }
 
+uint8_t tfvt::get_occupied_seats() {
+	return uint8_t(get_board_list().size());
+}
+
+vector<name>& tfvt::get_board_list() {
+	//NOTE: configs written before board_members existed are rebuilt once from the boardmembers table
+	if(!_config.board_members.has_value()) {
+		members_table members(get_self(), get_self().value);
+		vector<name> board;
+		for(auto itr = members.begin(); itr != members.end(); itr++) {
+			board.emplace_back(itr->member); //NOTE: primary key order is name order, so board stays sorted
+		}
+		_config.board_members.emplace(std::move(board));
+	}
+
+	return _config.board_members.value();
+}
+
 vector<tfvt::permission_level_weight> tfvt::perms_from_members() {
-	members_table members(get_self(), get_self().value);
-	auto itr = members.begin();
+	auto& board = get_board_list();
 	
 	vector<permission_level_weight> perms;
-	while(itr != members.end()) {
-			perms.emplace_back(permission_level_weight{ permission_level{
-				itr->member,
-				"active"_n
-			}, 1});
-		itr++;
+	perms.reserve(board.size());
+	for(const auto& member : board) {
+		perms.emplace_back(permission_level_weight{ permission_level{
+			member,
+			"active"_n
+		}, 1});
 	}
 
 	return perms;
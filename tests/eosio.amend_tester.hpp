@@ -53,9 +53,19 @@ class eosio_amend_tester : public eosio_trail_tester
 		}
 		produce_blocks(1);
 
-		REQUIRE_MATCHING_OBJECT(get_document(0), documents[0]);
-		REQUIRE_MATCHING_OBJECT(get_document(1), documents[1]);
-		REQUIRE_MATCHING_OBJECT(get_document(2), documents[2]);
+		for (int i = 0; i < documents.size(); i++)
+		{
+			auto clauses = documents[i]["clauses"].as<std::vector<std::string>>();
+			auto doc = get_document(i);
+			BOOST_REQUIRE_EQUAL(doc["document_title"].as<std::string>(), documents[i]["document_title"].as<std::string>());
+			BOOST_REQUIRE_EQUAL(doc["clause_count"].as<uint16_t>(), clauses.size());
+			BOOST_REQUIRE_EQUAL(doc["version"].as<uint32_t>(), 0);
+
+			for (int j = 0; j < clauses.size(); j++)
+			{
+				BOOST_REQUIRE_EQUAL(get_clause(i, j)["ipfs_url"].as<std::string>(), clauses[j]);
+			}
+		}
 	}
 
 	transaction_trace_ptr getdeposit(account_name owner)
@@ -128,6 +138,16 @@ class eosio_amend_tester : public eosio_trail_tester
 		return push_transaction(trx);
 	}
 
+	transaction_trace_ptr closemany(vector<uint64_t> sub_ids, account_name proposer)
+	{
+		signed_transaction trx;
+		trx.actions.emplace_back(get_action(N(eosio.amend), N(closemany), vector<permission_level>{{proposer, config::active_name}},
+											mvo()("sub_ids", sub_ids)));
+		set_transaction_headers(trx);
+		trx.sign(get_private_key(proposer, "active"), control->get_chain_id());
+		return push_transaction(trx);
+	}
+
 	transaction_trace_ptr set_env(
 		uint32_t expiration_length,
 		uint64_t fee,
@@ -158,6 +178,12 @@ class eosio_amend_tester : public eosio_trail_tester
 		return data.empty() ? fc::variant() : abi_ser.binary_to_variant("document", data, abi_serializer_max_time);
 	}
 
+	fc::variant get_clause(uint64_t doc_id, uint64_t clause_num)
+	{
+		vector<char> data = get_row_by_account(N(eosio.amend), doc_id, N(clauses), clause_num);
+		return data.empty() ? fc::variant() : abi_ser.binary_to_variant("clause", data, abi_serializer_max_time);
+	}
+
 	fc::variant get_submission(uint64_t sub_id)
 	{
 		vector<char> data = get_row_by_account(N(eosio.amend), N(eosio.amend), N(submissions), sub_id);
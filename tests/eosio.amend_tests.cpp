@@ -260,6 +260,152 @@ BOOST_FIXTURE_TEST_CASE( create_proposal_and_cancel, eosio_amend_tester ) try {
 } FC_LOG_AND_RETHROW()
 
 
+BOOST_FIXTURE_TEST_CASE( close_many_checks, eosio_amend_tester ) try {
+   int total_voters = test_voters.size();
+   name proposer = test_voters[total_voters - 1];
+   transfer(N(eosio), proposer.value, core_sym::from_string("300.0000"), "Blood Money");
+   produce_blocks(1);
+
+   set_env(uint32_t(2500000), uint64_t(1000000), uint32_t(864000000), double(5), double(66.67), double(4), double(25));
+   produce_blocks(1);
+
+   insert_default_docs();
+
+   transfer(proposer, eosio::chain::name("eosio.amend"), core_sym::from_string("200.0000"), "ratify fees");
+   produce_blocks(1);
+
+   for (int i = 0; i < 2; i++) {
+      makeproposal(
+         std::string("test ratify ") + std::to_string(i), 
+         uint64_t(0), 
+         uint8_t(i), 
+         std::string("https://web.ipfs.telosfoundation.io/32662273CFF99078EC3BFA5E7BBB1C369B1D3884DEDF2AF7D8748DEE080E4B99"), 
+         proposer
+      );
+      produce_blocks(1);
+   }
+
+   BOOST_REQUIRE_EXCEPTION( 
+      closemany(vector<uint64_t>{ 1, 0, 1 }, proposer), 
+      eosio_assert_message_exception, eosio_assert_message_is( "Duplicate submission id" )
+   );
+
+   BOOST_REQUIRE_EXCEPTION( 
+      closemany(vector<uint64_t>{ 2 }, proposer), 
+      eosio_assert_message_exception, eosio_assert_message_is( "Proposal Not Found" )
+   );
+
+   BOOST_REQUIRE_EXCEPTION( 
+      closemany(vector<uint64_t>{ 0, 1 }, proposer), 
+      eosio_assert_message_exception, eosio_assert_message_is( "Proposal is still open" )
+   );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( close_many_refunds, eosio_amend_tester ) try {
+   name proposer = test_voters[0];
+   symbol vote_symbol = symbol(4, "VOTE");
+
+   set_env(uint32_t(600), uint64_t(1000000), uint32_t(864000000), double(5), double(66.67), double(4), double(25));
+   produce_blocks(1);
+
+   insert_default_docs();
+
+   transfer(N(eosio), proposer.value, core_sym::from_string("200.0000"), "Blood Money");
+   transfer(proposer, eosio::chain::name("eosio.amend"), core_sym::from_string("200.0000"), "ratify fees");
+   produce_blocks(1);
+
+   for (int i = 0; i < 2; i++) {
+      makeproposal(
+         std::string("test ratify ") + std::to_string(i), 
+         uint64_t(0), 
+         uint8_t(i), 
+         std::string("https://web.ipfs.telosfoundation.io/close-many-") + std::to_string(i), 
+         proposer
+      );
+      openvoting(i, proposer);
+      produce_blocks(1);
+   }
+
+   register_voters(test_voters, 0, 10, vote_symbol);
+   voter_map(0, 10, [&](account_name voter) {
+      mirrorcast(voter, symbol(4, "TLOS"));
+      castvote(voter, get_submission(0)["ballot_id"].as<uint64_t>(), 1);
+      castvote(voter, get_submission(1)["ballot_id"].as<uint64_t>(), 1);
+   });
+   produce_blocks(1300);
+
+   asset pre_close_balance = get_balance(proposer);
+   asset pre_close_amend_balance = get_balance(N(eosio.amend));
+   auto trace = closemany(vector<uint64_t>{ 1, 0 }, proposer);
+   produce_blocks(1);
+
+   //both fees are refunded in a single transfer
+   BOOST_REQUIRE_EQUAL(1, count_transfers(trace));
+   BOOST_REQUIRE_EQUAL(get_balance(proposer), pre_close_balance + core_sym::from_string("200.0000"));
+   BOOST_REQUIRE_EQUAL(get_balance(N(eosio.amend)), pre_close_amend_balance - core_sym::from_string("200.0000"));
+
+   for (uint64_t i = 0; i < 2; i++) {
+      uint64_t ballot_id = get_submission(i)["ballot_id"].as<uint64_t>();
+      BOOST_REQUIRE_EQUAL(get_proposal(get_ballot(ballot_id)["reference_id"].as<uint64_t>())["status"].as<uint8_t>(), 1);
+   }
+   BOOST_REQUIRE_EQUAL(get_document(0)["version"].as<uint32_t>(), 2);
+
+   BOOST_REQUIRE_EXCEPTION( 
+      closemany(vector<uint64_t>{ 0 }, proposer), 
+      eosio_assert_message_exception, eosio_assert_message_is( "Proposal is already closed" )
+   );
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( ratified_proposal_updates_clauses, eosio_amend_tester ) try {
+   name proposer = test_voters[0];
+   symbol vote_symbol = symbol(4, "VOTE");
+   std::string amended_url = std::string("https://web.ipfs.telosfoundation.io/amended-clause-0.2");
+   std::string added_url = std::string("https://web.ipfs.telosfoundation.io/added-clause-0.4");
+
+   set_env(uint32_t(600), uint64_t(1000000), uint32_t(864000000), double(5), double(66.67), double(4), double(25));
+   produce_blocks(1);
+
+   insert_default_docs();
+
+   transfer(N(eosio), proposer.value, core_sym::from_string("100.0000"), "Blood Money");
+   transfer(proposer, eosio::chain::name("eosio.amend"), core_sym::from_string("100.0000"), "ratify fee");
+   produce_blocks(1);
+
+   makeproposal(std::string("amend document 0"), uint64_t(0), uint8_t(1), amended_url, proposer);
+   addclause(0, uint8_t(3), added_url, proposer);
+   openvoting(0, proposer);
+   produce_blocks(1);
+
+   uint64_t ballot_id = get_submission(0)["ballot_id"].as<uint64_t>();
+   register_voters(test_voters, 0, 10, vote_symbol);
+   voter_map(0, 10, [&](account_name voter) {
+      mirrorcast(voter, symbol(4, "TLOS"));
+      castvote(voter, ballot_id, 1);
+   });
+   produce_blocks(1300);
+
+   asset pre_close_balance = get_balance(proposer);
+   closeprop(0, proposer);
+   produce_blocks(1);
+
+   BOOST_REQUIRE_EQUAL(get_balance(proposer), pre_close_balance + core_sym::from_string("100.0000"));
+   BOOST_REQUIRE_EQUAL(get_proposal(get_ballot(ballot_id)["reference_id"].as<uint64_t>())["status"].as<uint8_t>(), 1);
+
+   auto doc = get_document(0);
+   BOOST_REQUIRE_EQUAL(doc["clause_count"].as<uint16_t>(), 4);
+   BOOST_REQUIRE_EQUAL(doc["version"].as<uint32_t>(), 1);
+   BOOST_REQUIRE(doc["last_amend"].as<uint32_t>() > 0);
+
+   auto clauses = documents[0]["clauses"].as<std::vector<std::string>>();
+   REQUIRE_MATCHING_OBJECT(get_clause(0, 0), mvo()("clause_num", 0)("ipfs_url", clauses[0])("version", 0));
+   REQUIRE_MATCHING_OBJECT(get_clause(0, 1), mvo()("clause_num", 1)("ipfs_url", amended_url)("version", 1));
+   REQUIRE_MATCHING_OBJECT(get_clause(0, 2), mvo()("clause_num", 2)("ipfs_url", clauses[2])("version", 0));
+   REQUIRE_MATCHING_OBJECT(get_clause(0, 3), mvo()("clause_num", 3)("ipfs_url", added_url)("version", 1));
+
+   //other documents are untouched
+   BOOST_REQUIRE_EQUAL(get_document(1)["version"].as<uint32_t>(), 0);
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( full_flow, eosio_amend_tester ) try {
 
 } FC_LOG_AND_RETHROW()
@@ -312,6 +312,82 @@ BOOST_FIXTURE_TEST_CASE( propose_approve_by_two, eosio_msig_tester ) try {
 } FC_LOG_AND_RETHROW()
 
 
+BOOST_FIXTURE_TEST_CASE( propose_approvemany_execute, eosio_msig_tester ) try {
+   const vector<permission_level> requested{ { N(bob), config::active_name },
+                                             { N(alice), config::owner_name },
+                                             { N(alice), config::active_name } };
+   auto trx = reqauth("alice", requested, abi_serializer_max_time );
+   push_action( N(alice), N(propose), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("trx",           trx)
+                  ("requested",     requested)
+   );
+
+   BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(approvemany), mvo()
+                                          ("proposer",      "alice")
+                                          ("proposal_name", "first")
+                                          ("levels",        vector<permission_level>{})
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("no permission levels to approve")
+   );
+
+   //a level can only be approved once
+   BOOST_REQUIRE_EXCEPTION( push_action( N(bob), N(approvemany), mvo()
+                                          ("proposer",      "alice")
+                                          ("proposal_name", "first")
+                                          ("levels",        vector<permission_level>{ { N(bob), config::active_name },
+                                                                                      { N(bob), config::active_name } })
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("approval is not on the list of requested approvals")
+   );
+
+   //approve with both permissions of alice at once
+   const vector<permission_level> alice_levels{ { N(alice), config::active_name }, { N(alice), config::owner_name } };
+   base_tester::push_action( N(eosio.msig), N(approvemany), alice_levels, mvo()
+                             ("proposer",      "alice")
+                             ("proposal_name", "first")
+                             ("levels",        alice_levels)
+   );
+   produce_block();
+
+   //fail because approval by bob is missing
+   BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(exec), mvo()
+                                          ("proposer",      "alice")
+                                          ("proposal_name", "first")
+                                          ("executer",      "alice")
+                            ),
+                            eosio_assert_message_exception,
+                            eosio_assert_message_is("transaction authorization failed")
+   );
+
+   push_action( N(bob), N(approve), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("level",         permission_level{ N(bob), config::active_name })
+   );
+
+   transaction_trace_ptr trace;
+   control->applied_transaction.connect(
+   [&]( std::tuple<const transaction_trace_ptr&, const signed_transaction&> p ) {
+      const auto& t = std::get<0>(p);
+      if( t->scheduled ) { trace = t; }
+   } );
+
+   push_action( N(alice), N(exec), mvo()
+                  ("proposer",      "alice")
+                  ("proposal_name", "first")
+                  ("executer",      "alice")
+   );
+
+   BOOST_REQUIRE( bool(trace) );
+   BOOST_REQUIRE_EQUAL( 1, trace->action_traces.size() );
+   BOOST_REQUIRE_EQUAL( transaction_receipt::executed, trace->receipt->status );
+} FC_LOG_AND_RETHROW()
+
+
 BOOST_FIXTURE_TEST_CASE( propose_with_wrong_requested_auth, eosio_msig_tester ) try {
    auto trx = reqauth("alice", vector<permission_level>{ { N(alice), config::active_name },  { N(bob), config::active_name } }, abi_serializer_max_time );
    //try with not enough requested auth
@@ -906,6 +982,11 @@ BOOST_FIXTURE_TEST_CASE( approve_with_hash, eosio_msig_tester ) try {
                   ("requested", vector<permission_level>{{ N(alice), config::active_name }})
    );
 
+   //proposal records the hash of the proposed transaction
+   auto prop = abi_ser.binary_to_variant( "proposal", get_row_by_account( N(eosio.msig), N(alice), N(proposal), N(first) ),
+                                          abi_serializer_max_time );
+   BOOST_REQUIRE( trx_hash == prop["trx_hash"].as<fc::sha256>() );
+
    //fail to approve with incorrect hash
    BOOST_REQUIRE_EXCEPTION( push_action( N(alice), N(approve), mvo()
                                           ("proposer",      "alice")
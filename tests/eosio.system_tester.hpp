@@ -280,6 +280,14 @@ public:
       return push_action( payer, N(buyrambytes), mvo()( "payer",payer)("receiver",receiver)("bytes",numbytes) );
    }
 
+   action_result buyrambatch( const account_name& payer, const std::vector<std::pair<account_name, uint32_t>>& purchases ) {
+      vector<fc::variant> v;
+      for ( const auto& p : purchases ) {
+         v.push_back( mvo()("first", p.first)("second", p.second) );
+      }
+      return push_action( payer, N(buyrambatch), mvo()( "payer",payer)("purchases",v) );
+   }
+
    action_result sellram( const account_name& account, uint64_t numbytes ) {
       return push_action( account, N(sellram), mvo()( "account", account)("bytes",numbytes) );
    }
@@ -619,6 +627,51 @@ public:
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant("rex_balance", data, abi_serializer_max_time);
    }
 
+   /// maturity buckets of a rex_balance object in order, with the savings bucket last
+   std::vector<std::pair<fc::time_point_sec, int64_t>> get_rex_maturities( const fc::variant& rex_balance_obj ) const {
+      std::vector<std::pair<fc::time_point_sec, int64_t>> maturities;
+      if ( !rex_balance_obj.get_object().contains( "maturity_buckets" ) ) {
+         for ( const auto& m : rex_balance_obj["rex_maturities"].get_array() ) {
+            maturities.emplace_back( m["first"].as<fc::time_point_sec>(), m["second"].as<int64_t>() );
+         }
+         return maturities;
+      }
+      const auto& buckets = rex_balance_obj["maturity_buckets"];
+      for ( const auto& m : buckets["buckets"].get_array() ) {
+         maturities.emplace_back( m["first"].as<fc::time_point_sec>(), m["second"].as<int64_t>() );
+      }
+      const int64_t savings = buckets["savings"].as<int64_t>();
+      if ( savings > 0 ) {
+         maturities.emplace_back( fc::time_point_sec::maximum(), savings );
+      }
+      return maturities;
+   }
+
+   /// rewrites the rexbal row of act in the version 0 layout, with all buckets in rex_maturities
+   void set_legacy_rex_balance( const account_name& act, const std::vector<std::pair<fc::time_point_sec, int64_t>>& maturities ) {
+      const fc::variant rb = get_rex_balance_obj( act );
+      vector<mvo> legacy_maturities;
+      for ( const auto& m : maturities ) {
+         legacy_maturities.emplace_back( mvo()("first", m.first)("second", m.second) );
+      }
+      const vector<char> data = abi_ser.variant_to_binary( "rex_balance", mvo()
+         ("version", 0)
+         ("owner", act)
+         ("vote_stake", rb["vote_stake"])
+         ("rex_balance", rb["rex_balance"])
+         ("matured_rex", rb["matured_rex"])
+         ("rex_maturities", legacy_maturities), abi_serializer_max_time );
+
+      auto& db = const_cast<chainbase::database&>( control->db() );
+      const auto* tbl = db.find<table_id_object, by_code_scope_table>( boost::make_tuple( config::system_account_name, config::system_account_name, N(rexbal) ) );
+      BOOST_REQUIRE( tbl != nullptr );
+      const auto* obj = db.find<key_value_object, by_scope_primary>( boost::make_tuple( tbl->id, act.value ) );
+      BOOST_REQUIRE( obj != nullptr );
+      db.modify( *obj, [&]( auto& kv ) {
+         kv.value.assign( data.data(), data.size() );
+      });
+   }
+
    asset get_rex_fund( const account_name& act ) const {
       vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(rexfund), act );
       return data.empty() ? asset(0, symbol{CORE_SYM}) : abi_ser.binary_to_variant("rex_fund", data, abi_serializer_max_time)["balance"].as<asset>();
@@ -649,6 +702,15 @@ public:
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "payrates", data, abi_serializer_max_time );
    }
 
+   action_result setrexbudget( uint16_t work_budget ) {
+      return push_action( config::system_account_name, N(setrexbudget), mvo()("work_budget", work_budget) );
+   }
+
+   fc::variant get_rex_maintenance() const {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(rexmaint), N(rexmaint) );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "rex_maintenance_state", data, abi_serializer_max_time );
+   }
+
    fc::variant get_rex_pool() const {
       vector<char> data;
       const auto& db = control->db();
@@ -702,6 +764,15 @@ public:
                           );
    }
 
+   action_result sweeprefunds( const account_name& sweeper, uint16_t max ) {
+      return push_action( name(sweeper), N(sweeprefunds), mvo()("max", max) );
+   }
+
+   fc::variant get_bid_refund( const account_name& bidder, const account_name& newname ) {
+      vector<char> data = get_row_by_account( config::system_account_name, newname, N(bidrefunds), bidder );
+      return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "bid_refund", data, abi_serializer_max_time );
+   }
+
    static fc::variant_object producer_parameters_example( int n ) {
       return mutable_variant_object()
          ("max_block_net_usage", 10000000 + n )
@@ -786,6 +857,27 @@ public:
                          ("producers", producers));
    }
 
+   action_result setlazyvotes( const account_name& voter, bool enabled ) {
+      return push_action(voter, N(setlazyvotes), mvo()
+                         ("voter",   voter)
+                         ("enabled", enabled));
+   }
+
+   action_result settlevotes( const account_name& settler, uint16_t max ) {
+      return push_action(settler, N(settlevotes), mvo()("max", max));
+   }
+
+   action_result setsettlemax( const account_name& signer, uint16_t onblock_budget ) {
+      return push_action(signer, N(setsettlemax), mvo()("onblock_budget", onblock_budget));
+   }
+
+   void produce_until_schedule_update() {
+      const auto last_update = get_global_state()["last_producer_schedule_update"].as_string();
+      while( last_update == get_global_state()["last_producer_schedule_update"].as_string() ) {
+         produce_block();
+      }
+   }
+
    uint32_t last_block_time() const {
       return time_point_sec( control->head_block_time() ).sec_since_epoch();
    }
@@ -935,6 +1027,16 @@ public:
    }
 
    fc::variant get_payment_info( name account ) {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(payledger), N(payledger) );
+      if (data.empty()) return fc::variant();
+      fc::variant ledger = abi_ser.binary_to_variant( "payment_ledger", data, abi_serializer_max_time );
+      for (const auto& entry : ledger["payments"].get_array()) {
+         if (entry["bp"].as<name>() == account) return entry;
+      }
+      return fc::variant();
+   }
+
+   fc::variant get_legacy_payment( name account ) {
       vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name, N(payments), account );
       return data.empty() ? fc::variant() : abi_ser.binary_to_variant( "payment_info", data, abi_serializer_max_time );
    }
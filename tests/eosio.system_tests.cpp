@@ -454,6 +454,93 @@ BOOST_FIXTURE_TEST_CASE( buysell, eosio_system_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( ram_market_closed_form, eosio_system_tester ) try {
+
+   const account_name alice = N(alice1111111);
+   transfer( config::system_account_name, alice, core_sym::from_string("10000000.0000"), config::system_account_name );
+   // first purchase in the block brings the ram supply up to date, so the market only moves with trades afterwards
+   BOOST_REQUIRE_EQUAL( success(), buyram( alice, alice, core_sym::from_string("10.0000") ) );
+
+   auto get_ram_market = [this]() -> fc::variant {
+      vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name,
+                                              N(rammarket), symbol{SY(4,RAMCORE)}.value() );
+      BOOST_REQUIRE( !data.empty() );
+      return abi_ser.binary_to_variant("exchange_state", data, abi_serializer_max_time);
+   };
+
+   // fixed-seed generator so failures are reproducible
+   uint64_t seed = 0x5eed;
+   auto next_random = [&seed]( uint64_t bound ) -> int64_t {
+      seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+      return ( seed >> 33 ) % bound;
+   };
+
+   for ( int i = 0; i < 200; ++i ) {
+      const auto market = get_ram_market();
+      const int64_t ram_reserve  = market["base"].as<connector>().balance.get_amount();
+      const int64_t core_reserve = market["quote"].as<connector>().balance.get_amount();
+      const uint64_t bytes0 = get_total_stake( alice )["ram_bytes"].as_uint64();
+
+      if ( i % 2 == 0 || bytes0 < 10000 ) {
+         const asset payment = asset( 10000 + next_random( 10000'0000 ), symbol{CORE_SYM} );
+         BOOST_REQUIRE_EQUAL( success(), buyram( alice, alice, payment ) );
+         const int64_t fee = ( payment.get_amount() + 199 ) / 200;
+         const int64_t net_payment = payment.get_amount() - fee;
+         BOOST_REQUIRE_EQUAL( uint64_t( bancor_convert( core_reserve, ram_reserve, net_payment ) ),
+                              get_total_stake( alice )["ram_bytes"].as_uint64() - bytes0 );
+         BOOST_REQUIRE_EQUAL( core_reserve + net_payment, get_ram_market()["quote"].as<connector>().balance.get_amount() );
+      } else {
+         const int64_t bytes = 1000 + next_random( bytes0 - 1000 );
+         const asset balance0 = get_balance( alice );
+         BOOST_REQUIRE_EQUAL( success(), sellram( alice, bytes ) );
+         const int64_t tokens_out = bancor_convert( ram_reserve, core_reserve, bytes );
+         const int64_t fee = ( tokens_out + 199 ) / 200;
+         BOOST_REQUIRE_EQUAL( balance0.get_amount() + tokens_out - fee, get_balance( alice ).get_amount() );
+         BOOST_REQUIRE_EQUAL( ram_reserve + bytes, get_ram_market()["base"].as<connector>().balance.get_amount() );
+      }
+   }
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( buy_ram_batch, eosio_system_tester ) try {
+
+   const account_name alice = N(alice1111111), bob = N(bob111111111), carol = N(carol1111111);
+   transfer( config::system_account_name, alice, core_sym::from_string("10000.0000"), config::system_account_name );
+   // first purchase in the block brings the ram supply up to date, so the market only moves with trades afterwards
+   BOOST_REQUIRE_EQUAL( success(), buyram( alice, alice, core_sym::from_string("10.0000") ) );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("no ram purchases"), buyrambatch( alice, {} ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("must purchase a positive amount"),
+                        buyrambatch( alice, { { bob, 4096 }, { carol, 0 } } ) );
+   BOOST_REQUIRE_EQUAL( error("missing authority of alice1111111"),
+                        push_action( bob, N(buyrambatch), mvo()("payer", alice)("purchases", vector<fc::variant>{}) ) );
+
+   vector<char> data = get_row_by_account( config::system_account_name, config::system_account_name,
+                                           N(rammarket), symbol{SY(4,RAMCORE)}.value() );
+   const auto market = abi_ser.binary_to_variant( "exchange_state", data, abi_serializer_max_time );
+   const int64_t ram_reserve  = market["base"].as<connector>().balance.get_amount();
+   const int64_t core_reserve = market["quote"].as<connector>().balance.get_amount();
+   const asset    balance0    = get_balance( alice );
+   const uint64_t bob_bytes   = get_total_stake( bob )["ram_bytes"].as_uint64();
+   const uint64_t carol_bytes = get_total_stake( carol )["ram_bytes"].as_uint64();
+
+   // bob is listed twice, the last entry receives the rounding remainder
+   BOOST_REQUIRE_EQUAL( success(), buyrambatch( alice, { { bob, 4096 }, { carol, 8192 }, { bob, 1024 } } ) );
+
+   const int64_t total_bytes   = 4096 + 8192 + 1024;
+   const int64_t cost          = double(core_reserve) * total_bytes / ( ram_reserve - total_bytes );
+   const int64_t cost_plus_fee = cost / double(0.995);
+   const int64_t fee           = ( cost_plus_fee + 199 ) / 200;
+   const int64_t bytes_out     = bancor_convert( core_reserve, ram_reserve, cost_plus_fee - fee );
+   const int64_t carol_share   = ( bytes_out * 8192 ) / total_bytes;
+
+   BOOST_REQUIRE( within_one( total_bytes, bytes_out ) );
+   BOOST_REQUIRE_EQUAL( balance0.get_amount() - cost_plus_fee, get_balance( alice ).get_amount() );
+   BOOST_REQUIRE_EQUAL( carol_bytes + carol_share, get_total_stake( carol )["ram_bytes"].as_uint64() );
+   BOOST_REQUIRE_EQUAL( bob_bytes + bytes_out - carol_share, get_total_stake( bob )["ram_bytes"].as_uint64() );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( stake_unstake, eosio_system_tester ) try {
    activate_network();
 
@@ -1274,6 +1361,84 @@ BOOST_FIXTURE_TEST_CASE( vote_same_producer_30_times, eosio_system_tester ) try
 } FC_LOG_AND_RETHROW()
 
 
+BOOST_FIXTURE_TEST_CASE( lazy_vote_settlement, eosio_system_tester, * boost::unit_test::tolerance(1e-4) ) try {
+   issue_and_transfer( "alice1111111", core_sym::from_string("1000.0000"),  config::system_account_name );
+   BOOST_REQUIRE_EQUAL( success(), push_action( N(alice1111111), N(regproducer), mvo()
+                                               ("producer",  "alice1111111")
+                                               ("producer_key", get_public_key(N(alice1111111), "active") )
+                                               ("url", "")
+                                               ("location", 0)
+                        )
+   );
+
+   issue_and_transfer( "bob111111111", core_sym::from_string("2000.0000"),  config::system_account_name );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "user must stake before they can change vote settlement" ),
+                        setlazyvotes( N(bob111111111), true ) );
+   BOOST_REQUIRE_EQUAL( success(), stake( "bob111111111", core_sym::from_string("11.0000"), core_sym::from_string("0.1111") ) );
+   BOOST_REQUIRE_EQUAL( success(), vote( N(bob111111111), { N(alice1111111) } ) );
+   BOOST_TEST( stake2votes("11.1111", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "action has no effect" ), setlazyvotes( N(bob111111111), false ) );
+   BOOST_REQUIRE_EQUAL( success(), setlazyvotes( N(bob111111111), true ) );
+
+   //stake changes only reach the voter row until settled
+   BOOST_REQUIRE_EQUAL( success(), stake( "bob111111111", core_sym::from_string("33.0000"), core_sym::from_string("0.3333") ) );
+   BOOST_REQUIRE_EQUAL( core_sym::from_string("44.4444").get_amount(), get_voter_info( "bob111111111" )["staked"].as_int64() );
+   BOOST_TEST( stake2votes("11.1111", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "max must be positive" ), settlevotes( N(carol1111111), 0 ) );
+   BOOST_REQUIRE_EQUAL( success(), settlevotes( N(carol1111111), 10 ) );
+   BOOST_TEST( stake2votes("44.4444", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+   BOOST_TEST( get_global_state()["total_producer_vote_weight"].as<double>() == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "no pending votes to settle" ), settlevotes( N(carol1111111), 10 ) );
+
+   //voting again settles the pending change
+   BOOST_REQUIRE_EQUAL( success(), unstake( "bob111111111", core_sym::from_string("11.0000"), core_sym::from_string("0.1111") ) );
+   BOOST_TEST( stake2votes("44.4444", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+   BOOST_REQUIRE_EQUAL( success(), vote( N(bob111111111), { N(alice1111111) } ) );
+   BOOST_TEST( stake2votes("33.3333", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "no pending votes to settle" ), settlevotes( N(carol1111111), 10 ) );
+
+   //opting out settles right away
+   BOOST_REQUIRE_EQUAL( success(), unstake( "bob111111111", core_sym::from_string("11.0000"), core_sym::from_string("0.1111") ) );
+   BOOST_TEST( stake2votes("33.3333", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+   BOOST_REQUIRE_EQUAL( success(), setlazyvotes( N(bob111111111), false ) );
+   BOOST_TEST( stake2votes("22.2222", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+
+   BOOST_REQUIRE_EQUAL( success(), stake( "bob111111111", core_sym::from_string("11.0000"), core_sym::from_string("0.1111") ) );
+   BOOST_TEST( stake2votes("33.3333", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+
+   BOOST_REQUIRE_EQUAL( error( "missing authority of eosio" ), setsettlemax( N(carol1111111), 1 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "onblock budget exceeds max_vote_settlements" ), setsettlemax( config::system_account_name, 21 ) );
+
+   //onblock leaves the queue alone when its budget is zero
+   activate_network();
+   BOOST_REQUIRE_EQUAL( success(), setsettlemax( config::system_account_name, 0 ) );
+   issue_and_transfer( "carol1111111", core_sym::from_string("2000.0000"),  config::system_account_name );
+   BOOST_REQUIRE_EQUAL( success(), stake( "carol1111111", core_sym::from_string("11.0000"), core_sym::from_string("0.1111") ) );
+   BOOST_REQUIRE_EQUAL( success(), vote( N(carol1111111), { N(alice1111111) } ) );
+   BOOST_REQUIRE_EQUAL( success(), setlazyvotes( N(carol1111111), true ) );
+   BOOST_REQUIRE_EQUAL( success(), setlazyvotes( N(bob111111111), true ) );
+   BOOST_TEST( stake2votes("44.4444", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+
+   //carol queues before bob, so she is settled first even though her name sorts after his
+   BOOST_REQUIRE_EQUAL( success(), stake( "carol1111111", core_sym::from_string("22.0000"), core_sym::from_string("0.2222") ) );
+   BOOST_REQUIRE_EQUAL( success(), stake( "bob111111111", core_sym::from_string("44.0000"), core_sym::from_string("0.4444") ) );
+   produce_until_schedule_update();
+   produce_until_schedule_update();
+   BOOST_TEST( stake2votes("44.4444", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+
+   BOOST_REQUIRE_EQUAL( success(), setsettlemax( config::system_account_name, 1 ) );
+   produce_until_schedule_update();
+   BOOST_TEST( stake2votes("66.6666", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+   produce_until_schedule_update();
+   BOOST_TEST( stake2votes("111.1110", 1, 1) == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+   BOOST_TEST( get_global_state()["total_producer_vote_weight"].as<double>() == get_producer_info( "alice1111111" )["total_votes"].as_double() );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "no pending votes to settle" ), settlevotes( N(carol1111111), 10 ) );
+
+} FC_LOG_AND_RETHROW()
+
+
 BOOST_FIXTURE_TEST_CASE( producer_keep_votes, eosio_system_tester, * boost::unit_test::tolerance(1e+5) ) try {
    issue_and_transfer( "alice1111111", core_sym::from_string("1000.0000"),  config::system_account_name );
    fc::variant params = producer_parameters_example(1);
@@ -1653,6 +1818,95 @@ BOOST_FIXTURE_TEST_CASE(producer_pay, eosio_system_tester, * boost::unit_test::t
    }
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(producer_pay_inactive_producer, eosio_system_tester) try {
+   const asset large_asset = core_sym::from_string("80.0000");
+   create_account_with_resources( N(defproducera), config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+   create_account_with_resources( N(defproducerb), config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+   create_account_with_resources( N(producvotera), config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+
+   BOOST_REQUIRE_EQUAL(success(), regproducer(N(defproducera)));
+   BOOST_REQUIRE_EQUAL(success(), regproducer(N(defproducerb)));
+   transfer(config::system_account_name, "producvotera", core_sym::from_string("400000000.0000"), config::system_account_name);
+   BOOST_REQUIRE_EQUAL(success(), stake("producvotera", core_sym::from_string("100000000.0000"), core_sym::from_string("100000000.0000")));
+   BOOST_REQUIRE_EQUAL(success(), vote( N(producvotera), { N(defproducera), N(defproducerb) }));
+
+   produce_blocks((1000 - get_global_state()["block_num"].as<uint32_t>()) + 1);
+   transfer(name("eosio"), name("exrsrv.tf"), core_sym::from_string("400000000.0000"), config::system_account_name);
+
+   produce_blocks(3600);
+   const asset first_pay = get_payment_info(N(defproducera))["pay"].as<asset>();
+   BOOST_REQUIRE(first_pay.get_amount() > 0);
+   BOOST_REQUIRE(get_legacy_payment(N(defproducera)).is_null());
+
+   //an unregistered producer's pay leaves the ledger for a payments row
+   BOOST_REQUIRE_EQUAL(success(), push_action(N(defproducera), N(unregprod), mvo()("producer", "defproducera")));
+   BOOST_REQUIRE_EQUAL(wasm_assert_msg("producer does not have an active key"),
+                       push_action(N(defproducera), N(claimrewards), mvo()("owner", "defproducera")));
+   produce_blocks(3600);
+   BOOST_REQUIRE(get_payment_info(N(defproducera)).is_null());
+   BOOST_REQUIRE(!get_payment_info(N(defproducerb)).is_null());
+   BOOST_REQUIRE_EQUAL(first_pay, get_legacy_payment(N(defproducera))["pay"].as<asset>());
+
+   //once active again, the payments row and new ledger pay are claimed together
+   BOOST_REQUIRE_EQUAL(success(), regproducer(N(defproducera)));
+   produce_blocks(3600);
+   const asset ledger_pay = get_payment_info(N(defproducera))["pay"].as<asset>();
+   BOOST_REQUIRE(ledger_pay.get_amount() > 0);
+   BOOST_REQUIRE_EQUAL(first_pay, get_legacy_payment(N(defproducera))["pay"].as<asset>());
+
+   const asset initial_balance = get_balance(N(defproducera));
+   const asset initial_bpay_balance = get_balance(N(eosio.bpay));
+   BOOST_REQUIRE_EQUAL(success(), push_action(N(defproducera), N(claimrewards), mvo()("owner", "defproducera")));
+   BOOST_REQUIRE_EQUAL(initial_balance + first_pay + ledger_pay, get_balance(N(defproducera)));
+   BOOST_REQUIRE_EQUAL(initial_bpay_balance - first_pay - ledger_pay, get_balance(N(eosio.bpay)));
+   BOOST_REQUIRE(get_payment_info(N(defproducera)).is_null());
+   BOOST_REQUIRE(get_legacy_payment(N(defproducera)).is_null());
+   BOOST_REQUIRE(!get_payment_info(N(defproducerb)).is_null());
+
+   BOOST_REQUIRE_EQUAL(wasm_assert_msg("No payment exists for account"),
+                       push_action(N(defproducera), N(claimrewards), mvo()("owner", "defproducera")));
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(proposed_schedule_hash, eosio_system_tester) try {
+   const asset large_asset = core_sym::from_string("80.0000");
+   const vector<account_name> producer_names = { N(defproducera), N(defproducerb), N(defproducerc) };
+   for (const auto& p : producer_names) {
+      create_account_with_resources( p, config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+   }
+   create_account_with_resources( N(producvotera), config::system_account_name, core_sym::from_string("1.0000"), false, large_asset, large_asset );
+
+   auto schedule_hash = [&](const vector<account_name>& names) {
+      vector<producer_key> schedule;
+      for (const auto& n : names) {
+         schedule.emplace_back( producer_key{ n, get_public_key(n, "active") } );
+      }
+      return fc::sha256::hash( fc::raw::pack( schedule ) ).str();
+   };
+
+   BOOST_REQUIRE_EQUAL(success(), regproducer(N(defproducera)));
+   BOOST_REQUIRE_EQUAL(success(), regproducer(N(defproducerb)));
+   transfer(config::system_account_name, "producvotera", core_sym::from_string("400000000.0000"), config::system_account_name);
+   BOOST_REQUIRE_EQUAL(success(), stake("producvotera", core_sym::from_string("100000000.0000"), core_sym::from_string("100000000.0000")));
+   BOOST_REQUIRE_EQUAL(success(), vote( N(producvotera), { N(defproducera), N(defproducerb) }));
+
+   produce_blocks((1000 - get_global_state()["block_num"].as<uint32_t>()) + 1);
+   produce_until_schedule_update();
+   BOOST_REQUIRE_EQUAL(schedule_hash({ N(defproducera), N(defproducerb) }), get_rotation_state()["last_proposed_hash"].as_string());
+
+   //a changed top-21 is proposed, retried until the chain takes it, and only then recorded
+   BOOST_REQUIRE_EQUAL(success(), regproducer(N(defproducerc)));
+   BOOST_REQUIRE_EQUAL(success(), vote( N(producvotera), producer_names ));
+   produce_until_schedule_update();
+   produce_blocks(720);
+
+   BOOST_REQUIRE_EQUAL(schedule_hash(producer_names), get_rotation_state()["last_proposed_hash"].as_string());
+   const auto producers = control->head_block_state()->active_schedule.producers;
+   BOOST_REQUIRE_EQUAL(producer_names.size(), producers.size());
+   for (size_t i = 0; i < producers.size(); i++) {
+      BOOST_REQUIRE_EQUAL(producer_names[i], producers[i].producer_name);
+   }
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE(multi_producer_pay, eosio_system_tester, * boost::unit_test::tolerance(1e-10)) try {
    const double usecs_per_year  = 52 * 7 * 24 * 3600 * 1000000ll;
    const double secs_per_year   = 52 * 7 * 24 * 3600;
@@ -2504,6 +2758,11 @@ BOOST_FIXTURE_TEST_CASE( multiple_namebids, eosio_system_tester ) try {
       const asset initial_names_balance = get_balance(N(eosio.names));
       BOOST_REQUIRE_EQUAL( success(),
                            bidname( "alice", "prefb", core_sym::from_string("1.1001") ) );
+      // refund is queued rather than sent in a deferred transaction
+      BOOST_REQUIRE_EQUAL( core_sym::from_string( "9996.9997" ), get_balance("bob") );
+      BOOST_REQUIRE_EQUAL( core_sym::from_string( "1.0000" ), get_bid_refund( N(bob), N(prefb) )["amount"].as<asset>() );
+      BOOST_REQUIRE_EQUAL( success(), sweeprefunds( N(carl), 10 ) );
+      BOOST_REQUIRE( get_bid_refund( N(bob), N(prefb) ).is_null() );
       BOOST_REQUIRE_EQUAL( core_sym::from_string( "9997.9997" ), get_balance("bob") );
       BOOST_REQUIRE_EQUAL( core_sym::from_string( "9998.8999" ), get_balance("alice") );
       BOOST_REQUIRE_EQUAL( initial_names_balance + core_sym::from_string("0.1001"), get_balance(N(eosio.names)) );
@@ -2515,6 +2774,8 @@ BOOST_FIXTURE_TEST_CASE( multiple_namebids, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( core_sym::from_string( "10000.0000" ), get_balance("david") );
       BOOST_REQUIRE_EQUAL( success(),
                            bidname( "david", "prefd", core_sym::from_string("1.9900") ) );
+      BOOST_REQUIRE_EQUAL( core_sym::from_string( "9998.0000" ), get_balance("carl") );
+      BOOST_REQUIRE_EQUAL( success(), sweeprefunds( N(david), 10 ) );
       BOOST_REQUIRE_EQUAL( core_sym::from_string( "9999.0000" ), get_balance("carl") );
       BOOST_REQUIRE_EQUAL( core_sym::from_string( "9998.0100" ), get_balance("david") );
    }
@@ -2523,6 +2784,12 @@ BOOST_FIXTURE_TEST_CASE( multiple_namebids, eosio_system_tester ) try {
    {
       BOOST_REQUIRE_EQUAL( success(),
                            bidname( "eve", "prefe", core_sym::from_string("1.7200") ) );
+      // carl claims the refund directly, the queued entry is dropped by the next sweep
+      BOOST_REQUIRE_EQUAL( success(), push_action( N(carl), N(bidrefund), mvo()("bidder", "carl")("newname", "prefe") ) );
+      BOOST_REQUIRE_EQUAL( core_sym::from_string( "10000.0000" ), get_balance("carl") );
+      BOOST_REQUIRE_EQUAL( success(), sweeprefunds( N(eve), 10 ) );
+      BOOST_REQUIRE_EQUAL( core_sym::from_string( "10000.0000" ), get_balance("carl") );
+      BOOST_REQUIRE_EQUAL( wasm_assert_msg("no bid refunds to sweep"), sweeprefunds( N(eve), 10 ) );
    }
 
    produce_block( fc::days(14) );
@@ -3345,7 +3612,7 @@ BOOST_FIXTURE_TEST_CASE( buy_sell_sell_rex, eosio_system_tester ) try {
    BOOST_REQUIRE_EQUAL( sellrex( alice, rex_tok ),                           wasm_assert_msg("insufficient funds for current and scheduled orders") );
    BOOST_REQUIRE_EQUAL( ratio * payment.get_amount() - rex_tok.get_amount(), get_rex_order( alice )["rex_requested"].as<asset>().get_amount() );
    BOOST_REQUIRE_EQUAL( success(),                                           consolidate( alice ) );
-   BOOST_REQUIRE_EQUAL( 0,                                                   get_rex_balance_obj( alice )["rex_maturities"].get_array().size() );
+   BOOST_REQUIRE_EQUAL( 0,                                                   get_rex_maturities( get_rex_balance_obj( alice ) ).size() );
 
    produce_block( fc::days(26) );
    produce_blocks(2);
@@ -3640,6 +3907,88 @@ BOOST_FIXTURE_TEST_CASE( rex_loans, eosio_system_tester ) try {
 } FC_LOG_AND_RETHROW()
 
 
+BOOST_FIXTURE_TEST_CASE( rex_loan_batch_matches_sequential, eosio_system_tester ) try {
+
+   const asset init_balance = core_sym::from_string("40000.0000");
+   const std::vector<account_name> accounts = { N(aliceaccount), N(bobbyaccount), N(carolaccount), N(emilyaccount), N(frankaccount) };
+   account_name alice = accounts[0], bob = accounts[1], carol = accounts[2], emily = accounts[3], frank = accounts[4];
+   setup_rex_accounts( accounts, init_balance );
+
+   BOOST_REQUIRE_EQUAL( success(), buyrex( alice, core_sym::from_string("25000.0000") ) );
+
+   // cpu loans 1-4 and net loans 5-6, some funded for renewal and some not, several sharing a receiver
+   BOOST_REQUIRE_EQUAL( success(), rentcpu( bob,   bob,   core_sym::from_string("10.0000"), core_sym::from_string("20.0000") ) );
+   BOOST_REQUIRE_EQUAL( success(), rentcpu( carol, emily, core_sym::from_string("10.0000") ) );
+   BOOST_REQUIRE_EQUAL( success(), rentcpu( bob,   emily, core_sym::from_string("5.0000"),  core_sym::from_string("5.0000") ) );
+   BOOST_REQUIRE_EQUAL( success(), rentcpu( frank, bob,   core_sym::from_string("8.0000") ) );
+   BOOST_REQUIRE_EQUAL( success(), rentnet( carol, carol, core_sym::from_string("10.0000"), core_sym::from_string("10.0000") ) );
+   BOOST_REQUIRE_EQUAL( success(), rentnet( bob,   emily, core_sym::from_string("7.0000") ) );
+
+   produce_block( fc::days(31) );
+
+   // replay the per-loan settlement against the pool as it is before maintenance
+   const auto init_pool = get_rex_pool();
+   int64_t total_rent   = init_pool["total_rent"].as<asset>().get_amount();
+   int64_t total_unlent = init_pool["total_unlent"].as<asset>().get_amount();
+   int64_t total_lent   = init_pool["total_lent"].as<asset>().get_amount();
+   std::map<uint64_t, int64_t> renewed;
+   std::vector<uint64_t> closed;
+   std::map<account_name, std::pair<int64_t, int64_t>> limit_deltas;
+   for ( uint64_t loan_num = 1; loan_num <= 6; ++loan_num ) {
+      const bool cpu = loan_num <= 4;
+      const auto loan = cpu ? get_cpu_loan( loan_num ) : get_net_loan( loan_num );
+      const int64_t staked  = loan["total_staked"].as<asset>().get_amount();
+      const int64_t payment = loan["payment"].as<asset>().get_amount();
+      const int64_t balance = loan["balance"].as<asset>().get_amount();
+
+      total_rent   -= bancor_convert( total_unlent, total_rent, staked );
+      total_unlent += staked;
+      total_lent   -= staked;
+      const int64_t rented_tokens = bancor_convert( total_rent, total_unlent, payment );
+      int64_t delta_stake = -staked;
+      if ( payment <= balance && payment < rented_tokens ) {
+         total_rent   += payment;
+         total_unlent -= rented_tokens;
+         total_lent   += rented_tokens;
+         total_unlent += payment;
+         renewed[loan_num] = rented_tokens;
+         delta_stake += rented_tokens;
+      } else {
+         closed.push_back( loan_num );
+      }
+      auto& delta = limit_deltas[ loan["receiver"].as<account_name>() ];
+      ( cpu ? delta.second : delta.first ) += delta_stake;
+   }
+   BOOST_REQUIRE( !renewed.empty() && !closed.empty() );
+
+   std::map<account_name, std::pair<int64_t, int64_t>> init_limits;
+   for ( const auto& d : limit_deltas ) {
+      init_limits[d.first] = { get_net_limit( d.first ), get_cpu_limit( d.first ) };
+   }
+
+   BOOST_REQUIRE_EQUAL( success(), rexexec( alice, 10 ) );
+
+   const auto pool = get_rex_pool();
+   BOOST_REQUIRE_EQUAL( total_rent,                pool["total_rent"].as<asset>().get_amount() );
+   BOOST_REQUIRE_EQUAL( total_unlent,              pool["total_unlent"].as<asset>().get_amount() );
+   BOOST_REQUIRE_EQUAL( total_lent,                pool["total_lent"].as<asset>().get_amount() );
+   BOOST_REQUIRE_EQUAL( total_unlent + total_lent, pool["total_lendable"].as<asset>().get_amount() );
+   BOOST_REQUIRE_EQUAL( init_pool["loan_num"].as_uint64(), pool["loan_num"].as_uint64() );
+
+   for ( const auto& r : renewed ) {
+      const auto loan = r.first <= 4 ? get_cpu_loan( r.first ) : get_net_loan( r.first );
+      BOOST_REQUIRE_EQUAL( r.second, loan["total_staked"].as<asset>().get_amount() );
+   }
+   for ( const auto& loan_num : closed ) {
+      BOOST_REQUIRE( ( loan_num <= 4 ? get_cpu_loan( loan_num ) : get_net_loan( loan_num ) ).is_null() );
+   }
+   for ( const auto& d : limit_deltas ) {
+      BOOST_REQUIRE_EQUAL( init_limits[d.first].first  + d.second.first,  get_net_limit( d.first ) );
+      BOOST_REQUIRE_EQUAL( init_limits[d.first].second + d.second.second, get_cpu_limit( d.first ) );
+   }
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( rex_loan_checks, eosio_system_tester ) try {
 
    const int64_t ratio        = 10000;
@@ -3710,6 +4059,7 @@ BOOST_FIXTURE_TEST_CASE( ramfee_namebid_to_rex, eosio_system_tester ) try {
    BOOST_REQUIRE_EQUAL( success(),                        bidname( carol, N(rndmbid), core_sym::from_string("23.7000") ) );
    BOOST_REQUIRE_EQUAL( core_sym::from_string("23.7000"), get_balance( N(eosio.names) ) );
    BOOST_REQUIRE_EQUAL( success(),                        bidname( alice, N(rndmbid), core_sym::from_string("29.3500") ) );
+   BOOST_REQUIRE_EQUAL( success(),                        sweeprefunds( alice, 10 ) );
    BOOST_REQUIRE_EQUAL( core_sym::from_string("29.3500"), get_balance( N(eosio.names) ));
 
    produce_block( fc::hours(24) );
@@ -3747,7 +4097,7 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
       auto rex_balance = get_rex_balance_obj( alice );
       BOOST_REQUIRE_EQUAL( 550000 * rex_ratio, rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( 0,                  rex_balance["matured_rex"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 2,                  rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                  get_rex_maturities( rex_balance ).size() );
 
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string("115000.0000 REX") ) );
@@ -3756,7 +4106,7 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
       rex_balance = get_rex_balance_obj( alice );
       BOOST_REQUIRE_EQUAL( 250000 * rex_ratio, rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( 0,                  rex_balance["matured_rex"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 1,                  rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                  get_rex_maturities( rex_balance ).size() );
       produce_block( fc::hours(23) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string("250000.0000 REX") ) );
@@ -3765,14 +4115,14 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
       rex_balance = get_rex_balance_obj( alice );
       BOOST_REQUIRE_EQUAL( 1200000000,         rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( 1200000000,         rex_balance["matured_rex"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 0,                  rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                  get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string("130000.0000 REX") ) );
       BOOST_REQUIRE_EQUAL( success(),          sellrex( alice, asset::from_string("120000.0000 REX") ) );
       rex_balance = get_rex_balance_obj( alice );
       BOOST_REQUIRE_EQUAL( 0,                  rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( 0,                  rex_balance["matured_rex"].as<int64_t>() );
-      BOOST_REQUIRE_EQUAL( 0,                  rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                  get_rex_maturities( rex_balance ).size() );
    }
 
    {
@@ -3789,23 +4139,23 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
 
       auto rex_balance = get_rex_balance_obj( bob );
       BOOST_REQUIRE_EQUAL( 8 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
-      BOOST_REQUIRE_EQUAL( 5,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 5,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 3 * rex_bucket.get_amount(), rex_balance["matured_rex"].as<int64_t>() );
 
       BOOST_REQUIRE_EQUAL( success(),                   updaterex( bob ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 4,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 4,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 4 * rex_bucket.get_amount(), rex_balance["matured_rex"].as<int64_t>() );
 
       produce_block( fc::hours(2) );
       BOOST_REQUIRE_EQUAL( success(),                   updaterex( bob ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 4,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 4,                           get_rex_maturities( rex_balance ).size() );
 
       produce_block( fc::hours(1) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, asset( 3 * rex_bucket.get_amount(), rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 4,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 4,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( rex_bucket.get_amount(),     rex_balance["matured_rex"].as<int64_t>() );
 
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
@@ -3813,18 +4163,18 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, asset( rex_bucket.get_amount(), rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
       BOOST_REQUIRE_EQUAL( 4 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
-      BOOST_REQUIRE_EQUAL( 4,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 4,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
 
       produce_block( fc::hours(23) );
       BOOST_REQUIRE_EQUAL( success(),                   updaterex( bob ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 3,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( rex_bucket.get_amount(),     rex_balance["matured_rex"].as<int64_t>() );
 
       BOOST_REQUIRE_EQUAL( success(),                   consolidate( bob ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
 
       produce_block( fc::days(3) );
@@ -3834,7 +4184,7 @@ BOOST_FIXTURE_TEST_CASE( rex_maturity, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, asset( 4 * rex_bucket.get_amount(), rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["rex_balance"].as<asset>().get_amount() );
-      BOOST_REQUIRE_EQUAL( 0,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 0,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
    }
 
@@ -3896,19 +4246,19 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
 
       auto rex_balance = get_rex_balance_obj( alice );
       BOOST_REQUIRE_EQUAL( 8 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
-      BOOST_REQUIRE_EQUAL( 5,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 5,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 4 * rex_bucket.get_amount(), rex_balance["matured_rex"].as<int64_t>() );
 
       BOOST_REQUIRE_EQUAL( success(),                   mvtosavings( alice, asset( 8 * rex_bucket.get_amount(), rex_sym ) ) );
       rex_balance = get_rex_balance_obj( alice );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       produce_block( fc::days(1000) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string( "1.0000 REX" ) ) );
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( alice, asset::from_string( "10.0000 REX" ) ) );
       rex_balance = get_rex_balance_obj( alice );
-      BOOST_REQUIRE_EQUAL( 2,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                           get_rex_maturities( rex_balance ).size() );
       produce_block( fc::days(3) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string( "1.0000 REX" ) ) );
@@ -3918,7 +4268,7 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
                            sellrex( alice, asset::from_string( "10.0001 REX" ) ) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( alice, asset::from_string( "10.0000 REX" ) ) );
       rex_balance = get_rex_balance_obj( alice );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturities( rex_balance ).size() );
       produce_block( fc::days(100) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( alice, asset::from_string( "0.0001 REX" ) ) );
@@ -3937,32 +4287,32 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
 
       auto rex_balance = get_rex_balance_obj( bob );
       BOOST_REQUIRE_EQUAL( 5 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
-      BOOST_REQUIRE_EQUAL( 5,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 5,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       BOOST_REQUIRE_EQUAL( success(),                   mvtosavings( bob, asset( rex_bucket.get_amount() / 2, rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 6,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 6,                           get_rex_maturities( rex_balance ).size() );
 
       BOOST_REQUIRE_EQUAL( success(),                   mvtosavings( bob, asset( rex_bucket.get_amount() / 2, rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 5,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 5,                           get_rex_maturities( rex_balance ).size() );
       produce_block( fc::days(1) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, rex_bucket ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 4,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 4,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       BOOST_REQUIRE_EQUAL( 4 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
 
       BOOST_REQUIRE_EQUAL( success(),                   mvtosavings( bob, asset( 3 * rex_bucket.get_amount() / 2, rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 3,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( bob, rex_bucket ) );
 
       produce_block( fc::days(1) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, rex_bucket ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 2,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       BOOST_REQUIRE_EQUAL( 3 * rex_bucket.get_amount(), rex_balance["rex_balance"].as<asset>().get_amount() );
 
@@ -3971,7 +4321,7 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
                            sellrex( bob, rex_bucket ) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, asset( rex_bucket.get_amount() / 2, rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       BOOST_REQUIRE_EQUAL( 5 * rex_bucket.get_amount(), 2 * rex_balance["rex_balance"].as<asset>().get_amount() );
 
@@ -3981,12 +4331,12 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient REX in savings"),
                            mvfrsavings( bob, asset( 3 * rex_bucket.get_amount(), rex_sym ) ) );
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( bob, rex_bucket ) );
-      BOOST_REQUIRE_EQUAL( 2,                           get_rex_balance_obj( bob )["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                           get_rex_maturities( get_rex_balance_obj( bob ) ).size() );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient REX balance"),
                            mvtosavings( bob, asset( 3 * rex_bucket.get_amount() / 2, rex_sym ) ) );
       produce_block( fc::days(1) );
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( bob, rex_bucket ) );
-      BOOST_REQUIRE_EQUAL( 3,                           get_rex_balance_obj( bob )["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturities( get_rex_balance_obj( bob ) ).size() );
       produce_block( fc::days(4) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, rex_bucket ) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
@@ -3994,22 +4344,22 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
       produce_block( fc::days(1) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, rex_bucket ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( rex_bucket.get_amount() / 2, rex_balance["rex_balance"].as<asset>().get_amount() );
 
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( bob, asset( rex_bucket.get_amount() / 4, rex_sym ) ) );
       produce_block( fc::days(2) );
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( bob, asset( rex_bucket.get_amount() / 8, rex_sym ) ) );
-      BOOST_REQUIRE_EQUAL( 3,                           get_rex_balance_obj( bob )["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturities( get_rex_balance_obj( bob ) ).size() );
       BOOST_REQUIRE_EQUAL( success(),                   consolidate( bob ) );
-      BOOST_REQUIRE_EQUAL( 2,                           get_rex_balance_obj( bob )["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                           get_rex_maturities( get_rex_balance_obj( bob ) ).size() );
 
       produce_block( fc::days(5) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient available rex"),
                            sellrex( bob, asset( rex_bucket.get_amount() / 2, rex_sym ) ) );
       BOOST_REQUIRE_EQUAL( success(),                   sellrex( bob, asset( 3 * rex_bucket.get_amount() / 8, rex_sym ) ) );
       rex_balance = get_rex_balance_obj( bob );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       BOOST_REQUIRE_EQUAL( rex_bucket.get_amount() / 8, rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( success(),                   mvfrsavings( bob, get_rex_balance( bob ) ) );
@@ -4054,21 +4404,21 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( rex_bucket,                  get_rex_balance( carol ) );
       auto rex_balance = get_rex_balance_obj( carol );
 
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
       produce_block( fc::days(1) );
       BOOST_REQUIRE_EQUAL( success(),                   buyrex( carol, payment ) );
       rex_balance = get_rex_balance_obj( carol );
-      BOOST_REQUIRE_EQUAL( 2,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 2,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 0,                           rex_balance["matured_rex"].as<int64_t>() );
 
       BOOST_REQUIRE_EQUAL( success(),                   mvtosavings( carol, half_rex_bucket ) );
       rex_balance = get_rex_balance_obj( carol );
-      BOOST_REQUIRE_EQUAL( 3,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturities( rex_balance ).size() );
 
       BOOST_REQUIRE_EQUAL( success(),                   buyrex( carol, half_payment ) );
       rex_balance = get_rex_balance_obj( carol );
-      BOOST_REQUIRE_EQUAL( 3,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 3,                           get_rex_maturities( rex_balance ).size() );
 
       produce_block( fc::days(5) );
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("asset must be a positive amount of (REX, 4)"),
@@ -4079,7 +4429,7 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
       BOOST_REQUIRE_EQUAL( wasm_assert_msg("insufficient REX in savings"),
                            mvfrsavings( carol, asset::from_string("0.0001 REX") ) );
       rex_balance = get_rex_balance_obj( carol );
-      BOOST_REQUIRE_EQUAL( 1,                           rex_balance["rex_maturities"].get_array().size() );
+      BOOST_REQUIRE_EQUAL( 1,                           get_rex_maturities( rex_balance ).size() );
       BOOST_REQUIRE_EQUAL( 5 * half_rex_bucket_amount,  rex_balance["rex_balance"].as<asset>().get_amount() );
       BOOST_REQUIRE_EQUAL( 2 * rex_bucket_amount,       rex_balance["matured_rex"].as<int64_t>() );
       produce_block( fc::days(5) );
@@ -4088,6 +4438,133 @@ BOOST_FIXTURE_TEST_CASE( rex_savings, eosio_system_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( rex_balance_working_copy, eosio_system_tester ) try {
+
+   const asset init_balance = core_sym::from_string("100000.0000");
+   const std::vector<account_name> accounts = { N(aliceaccount) };
+   account_name alice = accounts[0];
+   setup_rex_accounts( accounts, init_balance );
+
+   const int64_t rex_ratio = 10000;
+   const symbol  rex_sym( SY(4, REX) );
+   const asset   payment = core_sym::from_string("40.0000");
+   const int64_t rex_bucket_amount = rex_ratio * payment.get_amount();
+   const fc::time_point_sec end_of_days = fc::time_point_sec::maximum();
+
+   auto bucket_total = [&]( const fc::variant& rb ) {
+      int64_t total = rb["matured_rex"].as<int64_t>();
+      for ( const auto& m : get_rex_maturities( rb ) ) {
+         total += m.second;
+      }
+      return total;
+   };
+
+   BOOST_REQUIRE_EQUAL( success(), buyrex( alice, payment ) );
+   produce_block( fc::days(1) );
+   BOOST_REQUIRE_EQUAL( success(), buyrex( alice, payment ) );
+   auto rex_balance = get_rex_balance_obj( alice );
+   BOOST_REQUIRE_EQUAL( 2,                     get_rex_maturities( rex_balance ).size() );
+   BOOST_REQUIRE_EQUAL( 2 * rex_bucket_amount, rex_balance["rex_balance"].as<asset>().get_amount() );
+   BOOST_REQUIRE_EQUAL( 2 * rex_bucket_amount, bucket_total( rex_balance ) );
+   BOOST_REQUIRE_EQUAL( 1,                     rex_balance["version"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 0,                     rex_balance["rex_maturities"].get_array().size() );
+   BOOST_REQUIRE_EQUAL( 2,                     rex_balance["maturity_buckets"]["buckets"].get_array().size() );
+   BOOST_REQUIRE_EQUAL( 0,                     rex_balance["maturity_buckets"]["savings"].as<int64_t>() );
+
+   // savings bucket is read out, buckets are updated and savings are put back within a single row write
+   BOOST_REQUIRE_EQUAL( success(), mvtosavings( alice, asset( rex_bucket_amount / 2, rex_sym ) ) );
+   rex_balance = get_rex_balance_obj( alice );
+   BOOST_REQUIRE_EQUAL( 3,                     get_rex_maturities( rex_balance ).size() );
+   BOOST_REQUIRE( end_of_days == get_rex_maturities( rex_balance ).back().first );
+   BOOST_REQUIRE_EQUAL( rex_bucket_amount / 2, get_rex_maturities( rex_balance ).back().second );
+   BOOST_REQUIRE_EQUAL( 2 * rex_bucket_amount, bucket_total( rex_balance ) );
+
+   BOOST_REQUIRE_EQUAL( success(), mvfrsavings( alice, asset( rex_bucket_amount / 4, rex_sym ) ) );
+   rex_balance = get_rex_balance_obj( alice );
+   BOOST_REQUIRE( end_of_days == get_rex_maturities( rex_balance ).back().first );
+   BOOST_REQUIRE_EQUAL( rex_bucket_amount / 4, get_rex_maturities( rex_balance ).back().second );
+   BOOST_REQUIRE_EQUAL( 2 * rex_bucket_amount, bucket_total( rex_balance ) );
+
+   BOOST_REQUIRE_EQUAL( success(), consolidate( alice ) );
+   rex_balance = get_rex_balance_obj( alice );
+   BOOST_REQUIRE_EQUAL( 2,                     get_rex_maturities( rex_balance ).size() );
+   BOOST_REQUIRE_EQUAL( 0,                     rex_balance["matured_rex"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( 7 * rex_bucket_amount / 4, get_rex_maturities( rex_balance ).front().second );
+   BOOST_REQUIRE_EQUAL( rex_bucket_amount / 4, get_rex_maturities( rex_balance ).back().second );
+
+   // a buy after consolidation merges into the same maturity bucket and keeps savings last
+   BOOST_REQUIRE_EQUAL( success(), buyrex( alice, payment ) );
+   rex_balance = get_rex_balance_obj( alice );
+   BOOST_REQUIRE_EQUAL( 2,                     get_rex_maturities( rex_balance ).size() );
+   BOOST_REQUIRE_EQUAL( 11 * rex_bucket_amount / 4, get_rex_maturities( rex_balance ).front().second );
+   BOOST_REQUIRE( end_of_days == get_rex_maturities( rex_balance ).back().first );
+   BOOST_REQUIRE_EQUAL( 3 * rex_bucket_amount, bucket_total( rex_balance ) );
+
+   produce_block( fc::days(6) );
+   BOOST_REQUIRE_EQUAL( success(), sellrex( alice, asset( 11 * rex_bucket_amount / 4, rex_sym ) ) );
+   rex_balance = get_rex_balance_obj( alice );
+   BOOST_REQUIRE_EQUAL( 1,                     get_rex_maturities( rex_balance ).size() );
+   BOOST_REQUIRE_EQUAL( 0,                     rex_balance["matured_rex"].as<int64_t>() );
+   BOOST_REQUIRE_EQUAL( rex_bucket_amount / 4, rex_balance["rex_balance"].as<asset>().get_amount() );
+
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( rex_balance_migration, eosio_system_tester ) try {
+
+   const asset init_balance = core_sym::from_string("100000.0000");
+   const std::vector<account_name> accounts = { N(aliceaccount) };
+   account_name alice = accounts[0];
+   setup_rex_accounts( accounts, init_balance );
+
+   const int64_t rex_ratio = 10000;
+   const symbol  rex_sym( SY(4, REX) );
+   const asset   payment = core_sym::from_string("40.0000");
+   const int64_t rex_bucket_amount = rex_ratio * payment.get_amount();
+   const fc::time_point_sec end_of_days = fc::time_point_sec::maximum();
+
+   auto row_size = [&]() {
+      return get_row_by_account( config::system_account_name, config::system_account_name, N(rexbal), alice ).size();
+   };
+
+   BOOST_REQUIRE_EQUAL( success(), buyrex( alice, payment ) );
+   produce_block( fc::days(1) );
+   BOOST_REQUIRE_EQUAL( success(), buyrex( alice, payment ) );
+   BOOST_REQUIRE_EQUAL( success(), mvtosavings( alice, asset( rex_bucket_amount / 2, rex_sym ) ) );
+
+   const auto maturities = get_rex_maturities( get_rex_balance_obj( alice ) );
+   BOOST_REQUIRE_EQUAL( 3, maturities.size() );
+   BOOST_REQUIRE( end_of_days == maturities.back().first );
+   const size_t current_size = row_size();
+
+   // two maturity buckets and the savings bucket kept in the version 0 deque
+   set_legacy_rex_balance( alice, maturities );
+   auto rex_balance = get_rex_balance_obj( alice );
+   BOOST_REQUIRE_EQUAL( 0, rex_balance["version"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 3, rex_balance["rex_maturities"].get_array().size() );
+   BOOST_REQUIRE( !rex_balance.get_object().contains( "maturity_buckets" ) );
+   const size_t legacy_size = row_size();
+
+   BOOST_REQUIRE_EQUAL( success(), updaterex( alice ) );
+   rex_balance = get_rex_balance_obj( alice );
+   BOOST_REQUIRE_EQUAL( 1, rex_balance["version"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 0, rex_balance["rex_maturities"].get_array().size() );
+   BOOST_REQUIRE_EQUAL( 2, rex_balance["maturity_buckets"]["buckets"].get_array().size() );
+   BOOST_REQUIRE_EQUAL( rex_bucket_amount / 2, rex_balance["maturity_buckets"]["savings"].as<int64_t>() );
+
+   const auto migrated = get_rex_maturities( rex_balance );
+   BOOST_REQUIRE_EQUAL( maturities.size(), migrated.size() );
+   for ( size_t i = 0; i < maturities.size(); ++i ) {
+      BOOST_REQUIRE( maturities[i].first == migrated[i].first );
+      BOOST_REQUIRE_EQUAL( maturities[i].second, migrated[i].second );
+   }
+
+   // the 12 byte savings bucket becomes an 8 byte savings amount next to a 1 byte bucket count
+   BOOST_REQUIRE_EQUAL( current_size, row_size() );
+   BOOST_REQUIRE_EQUAL( legacy_size - 12 + 1 + 8, row_size() );
+   BOOST_REQUIRE( row_size() < legacy_size );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( update_rex, eosio_system_tester, * boost::unit_test::tolerance(1e-10) ) try {
 
    const asset init_balance = core_sym::from_string("30000.0000");
@@ -4423,6 +4900,46 @@ BOOST_FIXTURE_TEST_CASE( set_rex, eosio_system_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( rex_maintenance_budget, eosio_system_tester ) try {
+
+   const asset init_balance = core_sym::from_string("40000.0000");
+   const std::vector<account_name> accounts = { N(aliceaccount), N(bobbyaccount) };
+   account_name alice = accounts[0], bob = accounts[1];
+   setup_rex_accounts( accounts, init_balance );
+
+   BOOST_REQUIRE_EQUAL( error("missing authority of eosio"),
+                        push_action( alice, N(setrexbudget), mvo()("work_budget", 9) ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("work budget must be between 3 and 300"), setrexbudget( 2 ) );
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg("work budget must be between 3 and 300"), setrexbudget( 301 ) );
+   BOOST_REQUIRE_EQUAL( success(), setrexbudget( 9 ) );
+   BOOST_REQUIRE_EQUAL( 9,         get_rex_maintenance()["work_budget"].as<uint16_t>() );
+
+   BOOST_REQUIRE_EQUAL( success(), buyrex( alice, core_sym::from_string("25000.0000") ) );
+   const asset fee = core_sym::from_string("10.0000");
+   BOOST_REQUIRE_EQUAL( success(), rentcpu( bob, bob, fee ) );
+   BOOST_REQUIRE_EQUAL( success(), rentcpu( bob, alice, fee ) );
+   BOOST_REQUIRE_EQUAL( success(), rentnet( bob, bob, fee ) );
+
+   auto maint = get_rex_maintenance();
+   BOOST_REQUIRE_EQUAL( 2, maint["cpu_loans"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 1, maint["net_loans"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 0, maint["sell_orders"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 0, maint["processed"].as<uint64_t>() );
+
+   // loans have no fund for renewal, so a REX action after expiration closes all of them
+   produce_block( fc::days(31) );
+   BOOST_REQUIRE_EQUAL( success(), buyrex( alice, core_sym::from_string("1.0000") ) );
+   BOOST_REQUIRE_EQUAL( true,      get_cpu_loan(1).is_null() );
+   BOOST_REQUIRE_EQUAL( true,      get_cpu_loan(2).is_null() );
+   BOOST_REQUIRE_EQUAL( true,      get_net_loan(3).is_null() );
+
+   maint = get_rex_maintenance();
+   BOOST_REQUIRE_EQUAL( 0, maint["cpu_loans"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 0, maint["net_loans"].as<uint32_t>() );
+   BOOST_REQUIRE_EQUAL( 3, maint["processed"].as<uint64_t>() );
+
+} FC_LOG_AND_RETHROW()
+
 //NOTE: Removed the b1_vesting unit test because it does not apply to the telos version of the system contract.
 
 BOOST_AUTO_TEST_CASE( setabi_bios ) try {
@@ -100,6 +100,20 @@ public:
       );
    }
 
+   action_result transfermany( account_name                      from,
+                               vector<pair<account_name, asset>> transfers,
+                               string                            memo ) {
+      vector<mvo> entries;
+      for( const auto& t : transfers ) {
+         entries.emplace_back( mvo()( "first", t.first )( "second", t.second ) );
+      }
+      return push_action( from, N(transfermany), mvo()
+           ( "from", from)
+           ( "transfers", entries)
+           ( "memo", memo)
+      );
+   }
+
    action_result open( account_name owner,
                        const string& symbolname,
                        account_name ram_payer    ) {
@@ -346,6 +360,49 @@ BOOST_FIXTURE_TEST_CASE( transfer_tests, eosio_token_tester ) try {
 
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( transfermany_tests, eosio_token_tester ) try {
+
+   auto token = create( N(alice), asset::from_string("1000 CERO"));
+   produce_blocks(1);
+
+   issue( N(alice), asset::from_string("1000 CERO"), "hola" );
+
+   BOOST_REQUIRE_EQUAL( success(),
+      transfermany( N(alice), { { N(bob), asset::from_string("300 CERO") }, { N(carol), asset::from_string("200 CERO") }, { N(bob), asset::from_string("100 CERO") } }, "hola" )
+   );
+
+   REQUIRE_MATCHING_OBJECT( get_account(N(alice), "0,CERO"), mvo()
+      ("balance", "400 CERO")
+   );
+   REQUIRE_MATCHING_OBJECT( get_account(N(bob), "0,CERO"), mvo()
+      ("balance", "400 CERO")
+   );
+   REQUIRE_MATCHING_OBJECT( get_account(N(carol), "0,CERO"), mvo()
+      ("balance", "200 CERO")
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "overdrawn balance" ),
+      transfermany( N(alice), { { N(bob), asset::from_string("300 CERO") }, { N(carol), asset::from_string("101 CERO") } }, "hola" )
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "must transfer positive quantity" ),
+      transfermany( N(alice), { { N(bob), asset::from_string("10 CERO") }, { N(carol), asset::from_string("-10 CERO") } }, "hola" )
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "cannot transfer to self" ),
+      transfermany( N(alice), { { N(bob), asset::from_string("10 CERO") }, { N(alice), asset::from_string("10 CERO") } }, "hola" )
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "to account does not exist" ),
+      transfermany( N(alice), { { N(nonexistent), asset::from_string("10 CERO") } }, "hola" )
+   );
+
+   BOOST_REQUIRE_EQUAL( wasm_assert_msg( "must transfer to at least one account" ),
+      transfermany( N(alice), {}, "hola" )
+   );
+
+} FC_LOG_AND_RETHROW()
+
 BOOST_FIXTURE_TEST_CASE( open_tests, eosio_token_tester ) try {
 
    auto token = create( N(alice), asset::from_string("1000 CERO"));
@@ -206,6 +206,25 @@ class eosio_trail_tester : public tester
 		return data.empty() ? fc::variant() : abi_ser.binary_to_variant("vote_receipt", data, abi_serializer_max_time);
 	}
 
+	//NOTE: rewrites a receipt in the encoding used before direction bits, leaving out the extension fields
+	void set_legacy_vote_receipt(account_name voter, uint64_t ballot_id, vector<uint16_t> directions) {
+		fc::variant vr = get_vote_receipt(voter, ballot_id);
+		vector<char> data = abi_ser.variant_to_binary("vote_receipt", mvo()
+			("ballot_id", ballot_id)
+			("directions", directions)
+			("weight", vr["weight"])
+			("expiration", vr["expiration"]), abi_serializer_max_time);
+
+		auto& db = const_cast<chainbase::database&>(control->db());
+		const auto* tbl = db.find<table_id_object, by_code_scope_table>(boost::make_tuple(N(eosio.trail), voter, N(votereceipts)));
+		BOOST_REQUIRE(tbl != nullptr);
+		const auto* obj = db.find<key_value_object, by_scope_primary>(boost::make_tuple(tbl->id, ballot_id));
+		BOOST_REQUIRE(obj != nullptr);
+		db.modify(*obj, [&](auto& kv) {
+			kv.value.assign(data.data(), data.size());
+		});
+	}
+
 	fc::variant get_leaderboard(uint64_t board_id) {
 		vector<char> data = get_row_by_account(N(eosio.trail), N(eosio.trail), N(leaderboards), board_id);
 		return data.empty() ? fc::variant() : abi_ser.binary_to_variant("leaderboard", data, abi_serializer_max_time);
@@ -221,6 +240,11 @@ class eosio_trail_tester : public tester
 		return data.empty() ? fc::variant() : abi_ser.binary_to_variant("proposal", data, abi_serializer_max_time);
 	}
 
+	fc::variant get_result(uint64_t ballot_id) {
+		vector<char> data = get_row_by_account(N(eosio.trail), N(eosio.trail), N(results), ballot_id);
+		return data.empty() ? fc::variant() : abi_ser.binary_to_variant("ballot_result", data, abi_serializer_max_time);
+	}
+
 	fc::variant get_vote_counter_bal(account_name acc, symbol_code scope)
 	{
 		vector<char> data = get_row_by_account(N(eosio.trail), scope.value, N(counterbals), acc);
@@ -320,6 +344,23 @@ class eosio_trail_tester : public tester
 		return push_transaction( trx );
 	}
 
+	transaction_trace_ptr issuemany(account_name publisher, vector<std::pair<account_name, asset>> recipients) {
+		vector<mvo> recs;
+		for (const auto& rec : recipients) {
+			recs.push_back(mvo()("first", rec.first)("second", rec.second));
+		}
+		signed_transaction trx;
+		trx.actions.emplace_back( get_action(N(eosio.trail), N(issuemany), vector<permission_level>{{publisher, config::active_name}},
+			mvo()
+			("publisher", publisher)
+			("recipients", recs)
+			)
+		);
+		set_transaction_headers(trx);
+		trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+		return push_transaction( trx );
+	}
+
 	transaction_trace_ptr claimairgrab(account_name claimant, account_name publisher, symbol token_symbol) {
 		signed_transaction trx;
 		trx.actions.emplace_back( get_action(N(eosio.trail), N(claimairgrab), vector<permission_level>{{claimant, config::active_name}},
@@ -389,6 +430,20 @@ class eosio_trail_tester : public tester
 		return push_transaction( trx );
 	}
 
+	transaction_trace_ptr seizebygroup(account_name publisher, vector<account_name> group, asset amount) {
+		signed_transaction trx;
+		trx.actions.emplace_back( get_action(N(eosio.trail), N(seizebygroup), vector<permission_level>{{publisher, config::active_name}},
+			mvo()
+			("publisher", publisher)
+			("group", group)
+			("amount", amount)
+			)
+		);
+		set_transaction_headers(trx);
+		trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+		return push_transaction( trx );
+	}
+
 	transaction_trace_ptr raisemax(account_name publisher, asset amount) {
 		signed_transaction trx;
 		trx.actions.emplace_back( get_action(N(eosio.trail), N(raisemax), vector<permission_level>{{publisher, config::active_name}},
@@ -486,6 +541,19 @@ class eosio_trail_tester : public tester
 		return push_transaction( trx );
 	}
 
+	transaction_trace_ptr archiveballot(account_name publisher, uint64_t ballot_id) {
+		signed_transaction trx;
+		trx.actions.emplace_back( get_action(N(eosio.trail), N(archiveballot), vector<permission_level>{{publisher, config::active_name}},
+			mvo()
+			("publisher", publisher)
+			("ballot_id", ballot_id)
+			)
+		);
+		set_transaction_headers(trx);
+		trx.sign(get_private_key(publisher, "active"), control->get_chain_id());
+		return push_transaction( trx );
+	}
+
 	transaction_trace_ptr nextcycle(account_name publisher, uint64_t ballot_id, uint32_t new_begin_time, uint32_t new_end_time) {
 		signed_transaction trx;
 		trx.actions.emplace_back( get_action(N(eosio.trail), N(nextcycle), vector<permission_level>{{publisher, config::active_name}},
@@ -579,6 +647,16 @@ class eosio_trail_tester : public tester
 		return get_currency_balance(contract, balance_symbol, act);
 	}
 
+	int count_transfers(transaction_trace_ptr trace_ptr) {
+		int transfers = 0;
+		for(const auto& trace : trace_ptr->action_traces) {
+			if(trace.receiver == N(eosio.token) && trace.act.account == N(eosio.token) && trace.act.name == N(transfer)) {
+				transfers++;
+			}
+		}
+		return transfers;
+	}
+
 	void dump_trace(transaction_trace_ptr trace_ptr) {
 		std::cout << std::endl << "<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<" << std::endl;
 		for(auto trace : trace_ptr->action_traces) {
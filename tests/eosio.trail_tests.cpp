@@ -241,7 +241,20 @@ BOOST_FIXTURE_TEST_CASE( mirror_cast, eosio_trail_tester ) try {
 			("owner", "votedecay")
 			("decayable_cb", levy_amount_after_decay)
 			("persistent_cb", "0.0000 VOTE")
-			("last_decay", now() - 86400) //600 is the NUMBER OF BLOCKS PRODUCED in seconds AFTER TRANFER
+			("last_decay", now()) //NOTE: 86400 seconds is a whole number of decay periods, so last_decay catches up to now
+		);
+
+	//partial decay periods carry over to the next evaluation
+	uint32_t last_decay = now();
+	produce_block(fc::seconds(179));
+	mirrorcast(N(votedecay), symbol(4, "TLOS"));
+
+	levy_info = get_vote_counter_bal(N(votedecay), test_code);
+	REQUIRE_MATCHING_OBJECT(levy_info, mvo()
+			("owner", "votedecay")
+			("decayable_cb", "279.0000 VOTE")
+			("persistent_cb", "0.0000 VOTE")
+			("last_decay", last_decay + 120)
 		);
 } FC_LOG_AND_RETHROW()
 
@@ -609,6 +622,64 @@ BOOST_FIXTURE_TEST_CASE( full_proposal_flow, eosio_trail_tester ) try {
 	nextcycle(publisher, current_ballot_id, begin_time, end_time );
 	proposal_flow(1);
 
+	BOOST_REQUIRE_EXCEPTION(archiveballot(publisher, current_ballot_id), eosio_assert_message_exception,
+		eosio_assert_message_is("cannot archive proposal while voting is still open"));
+
+	produce_blocks();
+	produce_block(fc::seconds(end_time - now()));
+	produce_blocks(2);
+
+	BOOST_REQUIRE_EXCEPTION(archiveballot(publisher, current_ballot_id), eosio_assert_message_exception,
+		eosio_assert_message_is("cannot archive proposal before it is closed"));
+
+	closeballot(publisher, current_ballot_id, 1);
+	proposal_info = get_proposal(current_proposal_id);
+	archiveballot(publisher, current_ballot_id);
+	produce_blocks();
+
+	BOOST_REQUIRE_EQUAL(true, get_proposal(current_proposal_id).is_null());
+	BOOST_REQUIRE_EQUAL(false, get_ballot(current_ballot_id).is_null());
+	REQUIRE_MATCHING_OBJECT(get_result(current_ballot_id), mvo()
+		("ballot_id", current_ballot_id)
+		("table_id", ballot_type)
+		("publisher", publisher.to_string())
+		("members", vector<name>())
+		("tallies", vector<string>{ proposal_info["no_count"].as_string(), proposal_info["yes_count"].as_string(), proposal_info["abstain_count"].as_string() })
+		("unique_voters", proposal_info["unique_voters"])
+		("end_time", end_time)
+		("status", 1)
+	);
+
+	BOOST_REQUIRE_EXCEPTION(archiveballot(publisher, current_ballot_id), eosio_assert_message_exception,
+		eosio_assert_message_is("ballot has been archived"));
+	REQUIRE_MATCHING_OBJECT(get_ballot(current_ballot_id), mvo()
+		("ballot_id", current_ballot_id)
+		("table_id", 255)
+		("reference_id", current_proposal_id)
+	);
+
+	//the next proposal reuses the archived proposal id, but only its own ballot reaches it
+	begin_time = now() + 20;
+	end_time   = now() + ballot_length;
+	regballot(publisher, ballot_type, test_symbol, begin_time, end_time, info_url);
+	REQUIRE_MATCHING_OBJECT(get_ballot(current_ballot_id + 1), mvo()
+		("ballot_id", current_ballot_id + 1)
+		("table_id", ballot_type)
+		("reference_id", current_proposal_id)
+	);
+	produce_blocks( 41 );
+
+	BOOST_REQUIRE_EXCEPTION(castvote(test_voters[0].value, current_ballot_id, 1), eosio_assert_message_exception,
+		eosio_assert_message_is("ballot has been archived"));
+	BOOST_REQUIRE_EXCEPTION(closeballot(publisher, current_ballot_id, 1), eosio_assert_message_exception,
+		eosio_assert_message_is("ballot has been archived"));
+	BOOST_REQUIRE_EXCEPTION(nextcycle(publisher, current_ballot_id, begin_time, end_time), eosio_assert_message_exception,
+		eosio_assert_message_is("ballot has been archived"));
+
+	castvote(test_voters[0].value, current_ballot_id + 1, 1);
+	produce_blocks();
+	BOOST_REQUIRE_EQUAL(1u, get_proposal(current_proposal_id)["unique_voters"].as<uint32_t>());
+
 } FC_LOG_AND_RETHROW()
 
 BOOST_FIXTURE_TEST_CASE( full_leaderboard_flow, eosio_trail_tester ) try {
@@ -721,15 +792,20 @@ BOOST_FIXTURE_TEST_CASE( full_leaderboard_flow, eosio_trail_tester ) try {
 
 		vote_receipt_info = get_vote_receipt(test_voters[i].value, current_ballot_id);
 		BOOST_REQUIRE_EQUAL(false, vote_receipt_info.is_null());
-		BOOST_REQUIRE_EQUAL(false, vote_receipt_info["directions"].is_null());
-		std::cout << "directions.size(): " << vote_receipt_info["directions"].get_array().size() << std::endl;
-		BOOST_REQUIRE_EQUAL(true, vote_receipt_info["directions"].get_array().size() > 0);
+		//leaderboard receipts keep one bit per candidate instead of a list of directions
 		REQUIRE_MATCHING_OBJECT(vote_receipt_info, mvo()
 			("ballot_id", current_ballot_id)
-			("directions", vote_directions)
+			("directions", vector<uint16_t>())
 			("weight", voter_total.to_string())
 			("expiration", end_time)
+			("version", 1)
 		);
+		vector<uint8_t> direction_bits = vote_receipt_info["direction_bits"].as<vector<uint8_t>>();
+		BOOST_REQUIRE_EQUAL(1u, direction_bits.size());
+		for (uint16_t d : vote_directions) {
+			BOOST_REQUIRE_EQUAL(1, (direction_bits[0] >> d) & 1);
+		}
+		BOOST_REQUIRE_EQUAL(vote_directions.size(), size_t(__builtin_popcount(direction_bits[0])));
 
 		deloldvotes(test_voters[i].value, 1);
 		vote_receipt_info = get_vote_receipt(test_voters[i].value, current_ballot_id);
@@ -749,6 +825,82 @@ BOOST_FIXTURE_TEST_CASE( full_leaderboard_flow, eosio_trail_tester ) try {
 	for(int i = 0; i < candidates_from_board.size(); i++) {
 		REQUIRE_MATCHING_OBJECT(candidates[i], candidates_from_board[i]);
 	}
+
+	BOOST_REQUIRE_EXCEPTION(archiveballot(publisher, current_ballot_id), eosio_assert_message_exception,
+		eosio_assert_message_is("cannot archive leaderboard while voting is still open"));
+
+	produce_blocks();
+	produce_block(fc::seconds(end_time - now()));
+	produce_blocks(2);
+
+	BOOST_REQUIRE_EXCEPTION(archiveballot(publisher, current_ballot_id), eosio_assert_message_exception,
+		eosio_assert_message_is("cannot archive leaderboard before it is closed"));
+
+	closeballot(publisher, current_ballot_id, 1);
+	archiveballot(publisher, current_ballot_id);
+	produce_blocks();
+
+	BOOST_REQUIRE_EQUAL(true, get_leaderboard(current_leaderboard_id).is_null());
+	BOOST_REQUIRE_EQUAL(false, get_ballot(current_ballot_id).is_null());
+	REQUIRE_MATCHING_OBJECT(get_result(current_ballot_id), mvo()
+		("ballot_id", current_ballot_id)
+		("table_id", ballot_type)
+		("publisher", publisher.to_string())
+		("members", vector<string>{ "voteraaaaaab", "voteraaaaaac", "voteraaaaaad" })
+		("tallies", vector<string>{ candidate_votes[0].to_string(), candidate_votes[1].to_string(), candidate_votes[2].to_string() })
+		("unique_voters", unique_voters)
+		("end_time", end_time)
+		("status", 1)
+	);
+
+	BOOST_REQUIRE_EXCEPTION(archiveballot(publisher, current_ballot_id), eosio_assert_message_exception,
+		eosio_assert_message_is("ballot has been archived"));
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( legacy_receipt_conversion, eosio_trail_tester ) try {
+	account_name publisher = N(voteraaaaaaa);
+	account_name voter = test_voters[0];
+	uint64_t current_ballot_id = 0;
+	uint32_t begin_time = now() + 20;
+	uint32_t end_time   = now() + 1200;
+	symbol test_symbol = symbol(4, "VOTE");
+
+	regballot(publisher, uint8_t(2), test_symbol, begin_time, end_time, "9bd47bae-f436-11e8-8eb2-f2801f1b9fd1");
+	setseats(publisher, current_ballot_id, 3);
+	addcandidate(publisher, current_ballot_id, N(voteraaaaaab), "Qm1");
+	addcandidate(publisher, current_ballot_id, N(voteraaaaaac), "Qm2");
+	addcandidate(publisher, current_ballot_id, N(voteraaaaaad), "Qm3");
+	produce_blocks( 41 );
+
+	regvoter(voter.value, test_symbol);
+	mirrorcast(voter.value, symbol(4, "TLOS"));
+	castvote(voter.value, current_ballot_id, 2);
+	produce_blocks( 2 );
+
+	//receipts written before direction bits only carry the list of directions
+	set_legacy_vote_receipt(voter, current_ballot_id, vector<uint16_t>{ 2, 0 });
+	auto vote_receipt_info = get_vote_receipt(voter, current_ballot_id);
+	BOOST_REQUIRE_EQUAL(false, vote_receipt_info.get_object().contains("version"));
+	BOOST_REQUIRE(vector<uint16_t>({ 2, 0 }) == vote_receipt_info["directions"].as<vector<uint16_t>>());
+
+	BOOST_REQUIRE_EXCEPTION(castvote(voter.value, current_ballot_id, 0), eosio_assert_message_exception,
+		eosio_assert_message_is("token registry disallows vote recasting"));
+
+	//the next new direction converts the receipt, keeping the legacy directions
+	castvote(voter.value, current_ballot_id, 1);
+	produce_blocks( 2 );
+
+	vote_receipt_info = get_vote_receipt(voter, current_ballot_id);
+	REQUIRE_MATCHING_OBJECT(vote_receipt_info, mvo()
+		("ballot_id", current_ballot_id)
+		("directions", vector<uint16_t>())
+		("expiration", end_time)
+		("version", 1)
+	);
+	BOOST_REQUIRE(vector<uint8_t>({ 0x07 }) == vote_receipt_info["direction_bits"].as<vector<uint8_t>>());
+
+	BOOST_REQUIRE_EXCEPTION(castvote(voter.value, current_ballot_id, 2), eosio_assert_message_exception,
+		eosio_assert_message_is("token registry disallows vote recasting"));
 } FC_LOG_AND_RETHROW()
 
 BOOST_FIXTURE_TEST_CASE( custom_token_voting, eosio_trail_tester ) try {
@@ -1110,6 +1262,42 @@ BOOST_FIXTURE_TEST_CASE( token_functions, eosio_trail_tester ) try {
 
 	produce_blocks(2);
 
+	//issue to several recipients at once
+	asset supply_before = get_registry(test_symbol)["supply"].as<asset>();
+	issuemany(publisher, { {N(voteraaaaaab), asset(200, test_symbol)}, {N(voteraaaaaae), asset(300, test_symbol)} });
+	BOOST_REQUIRE_EQUAL(supply_before + asset(500, test_symbol), get_registry(test_symbol)["supply"].as<asset>());
+	REQUIRE_MATCHING_OBJECT(get_voter(N(voteraaaaaab), test_symbol.to_symbol_code()), mvo()
+		("owner", "voteraaaaaab")
+		("tokens", "5.00 CRAIG")
+	);
+	REQUIRE_MATCHING_OBJECT(get_voter(N(voteraaaaaae), test_symbol.to_symbol_code()), mvo()
+		("owner", "voteraaaaaae")
+		("tokens", "3.00 CRAIG")
+	);
+	BOOST_REQUIRE_EXCEPTION(issuemany(publisher, { {N(voteraaaaaab), asset(100, test_symbol)}, {N(voteraaaaaae), asset(0, test_symbol)} }),
+		eosio_assert_message_exception, eosio_assert_message_is( "must issue more than 0 tokens" )
+	);
+
+	//seize from several accounts, publisher is credited the total
+	seizebygroup(publisher, { N(voteraaaaaab), N(voteraaaaaae) }, asset(150, test_symbol));
+	REQUIRE_MATCHING_OBJECT(get_voter(N(voteraaaaaab), test_symbol.to_symbol_code()), mvo()
+		("owner", "voteraaaaaab")
+		("tokens", "3.50 CRAIG")
+	);
+	REQUIRE_MATCHING_OBJECT(get_voter(N(voteraaaaaae), test_symbol.to_symbol_code()), mvo()
+		("owner", "voteraaaaaae")
+		("tokens", "1.50 CRAIG")
+	);
+	REQUIRE_MATCHING_OBJECT(get_voter(N(voteraaaaaaa), test_symbol.to_symbol_code()), mvo()
+		("owner", "voteraaaaaaa")
+		("tokens", "9.00 CRAIG")
+	);
+	BOOST_REQUIRE_EXCEPTION(seizebygroup(publisher, { N(voteraaaaaab), N(voteraaaaaae) }, asset(200, test_symbol)),
+		eosio_assert_message_exception, eosio_assert_message_is( "cannot seize more tokens than user owns" )
+	);
+
+	produce_blocks(2);
+
 	//TODO: test raising/lowering max
 
 
@@ -89,6 +89,16 @@ class eosio_wps_tester : public eosio_trail_tester
         return push_wps_action(proposer, N(claim), mvo()("sub_id", sub_id)("proposer", proposer));
     }
 
+    transaction_trace_ptr claimmany(vector<uint64_t> sub_ids, account_name proposer)
+    {
+        signed_transaction trx;
+        trx.actions.emplace_back(get_action(N(eosio.saving), N(claimmany), vector<permission_level>{{proposer, config::active_name}},
+                                            mvo()("sub_ids", sub_ids)));
+        set_transaction_headers(trx);
+        trx.sign(get_private_key(proposer, "active"), control->get_chain_id());
+        return push_transaction(trx);
+    }
+
     fc::variant get_wps_info(const uint64_t id)
     {
         vector<char> data = get_row_by_account(N(eosio.saving), N(eosio.saving), N(proposals), id);
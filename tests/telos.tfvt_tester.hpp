@@ -169,6 +169,36 @@ class telos_tfvt_tester : public eosio_trail_tester {
 		}
 	}
 
+	// reference ranking used before top-k selection: full sort by votes, then drop every candidate tied with the first one left out
+	vector<name> full_sort_winners(const fc::variant& board) {
+		vector<pair<name, asset>> cands;
+		for(auto& c : board["candidates"].get_array()) {
+			cands.emplace_back(c["member"].as<name>(), c["votes"].as<asset>());
+		}
+		size_t seats = board["available_seats"].as<uint8_t>();
+
+		sort(cands.begin(), cands.end(), [](const auto &c1, const auto &c2) { return c1.second > c2.second; });
+		if(cands.size() > seats) {
+			auto first_cand_out = cands[seats];
+			cands.resize(seats);
+			while(!cands.empty() && cands.back().second == first_cand_out.second) cands.pop_back();
+		}
+
+		vector<name> winners;
+		for(auto& c : cands) {
+			if(c.second.get_amount() > 0) winners.emplace_back(c.first);
+		}
+		return winners;
+	}
+
+	void check_board_matches(const fc::variant& board, const vector<name>& expected) {
+		for(auto& c : board["candidates"].get_array()) {
+			auto member = c["member"].as<name>();
+			bool is_expected = std::find(expected.begin(), expected.end(), member) != expected.end();
+			BOOST_REQUIRE_EQUAL(is_expected, !get_board_member(member).is_null());
+		}
+	}
+
 	transaction_trace_ptr inittfvt(string initial_info_link) {
 		signed_transaction trx;
 		trx.actions.emplace_back( get_action(N(tf), N(inittfvt), vector<permission_level>{{N(tf), config::active_name}},
@@ -238,6 +238,10 @@ try
 	BOOST_REQUIRE_EQUAL(get_nominee(nontfvt).is_null(), true);
 	BOOST_REQUIRE_EQUAL(get_board_member(nontfvt)["member"].as<name>(), nontfvt);
 
+	auto board_list = get_config()["board_members"].as<vector<name>>();
+	BOOST_REQUIRE_EQUAL(board_list.size(), 1);
+	BOOST_REQUIRE_EQUAL(board_list[0], nontfvt);
+
 	BOOST_REQUIRE_EXCEPTION(
 		makeelection(holder, info_link),
 		eosio_assert_message_exception, 
@@ -747,4 +751,65 @@ try
 }
 FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE(endelection_ties_for_last_seat, telos_tfvt_tester)
+try
+{
+	auto holder = test_voters[0];
+	prepare_election(8, 100, 3);
+	produce_block(fc::seconds(100));
+	produce_blocks();
+
+	cast_votes(0, 5, 0, 1);		// candidate 0 => 5 votes
+	cast_votes(5, 9, 1, 3);		// candidates 1, 2 => 4 votes
+	cast_votes(9, 13, 3, 5);	// candidates 3, 4 => 4 votes
+	cast_votes(13, 15, 5, 6);	// candidate 5 => 2 votes
+	cast_votes(15, 16, 6, 7);	// candidate 6 => 1 vote
+
+	produce_block(fc::seconds(1000));
+	produce_blocks();
+
+	auto ballot = get_ballot(get_config()["open_election_id"].as_uint64());
+	auto leaderboard = get_leaderboard(ballot["reference_id"].as_uint64());
+	auto expected = full_sort_winners(leaderboard);
+
+	endelection(holder);
+	produce_blocks();
+
+	// four candidates tie for the last two seats, so only candidate 0 is seated
+	BOOST_REQUIRE_EQUAL(expected.size(), 1);
+	BOOST_REQUIRE_EQUAL(expected[0], board_members[0]);
+	check_board_matches(leaderboard, expected);
+	BOOST_REQUIRE_EQUAL(get_config()["open_seats"].as<uint8_t>(), uint8_t(2));
+}
+FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE(endelection_ranks_top_seats, telos_tfvt_tester)
+try
+{
+	auto holder = test_voters[0];
+	prepare_election(6, 100, 3);
+	produce_block(fc::seconds(100));
+	produce_blocks();
+
+	cast_votes(0, 5, 0, 1);		// candidate 0 => 5 votes
+	cast_votes(5, 9, 1, 2);		// candidate 1 => 4 votes
+	cast_votes(9, 12, 2, 3);	// candidate 2 => 3 votes
+	cast_votes(12, 14, 3, 5);	// candidates 3, 4 => 2 votes
+
+	produce_block(fc::seconds(1000));
+	produce_blocks();
+
+	auto ballot = get_ballot(get_config()["open_election_id"].as_uint64());
+	auto leaderboard = get_leaderboard(ballot["reference_id"].as_uint64());
+	auto expected = full_sort_winners(leaderboard);
+
+	endelection(holder);
+	produce_blocks();
+
+	BOOST_REQUIRE_EQUAL(expected.size(), 3);
+	check_board_matches(leaderboard, expected);
+	BOOST_REQUIRE_EQUAL(get_config()["open_seats"].as<uint8_t>(), uint8_t(0));
+}
+FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()